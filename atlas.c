@@ -0,0 +1,148 @@
+#include "atlas.h"
+#include "loader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* path;
+    int page;
+    SDL_Rect src;
+} AtlasEntry;
+
+static AtlasEntry atlasEntries[MAX_ATLAS_ENTRIES];
+static int atlasEntryCount = 0;
+static SDL_Texture* atlasPages[MAX_ATLAS_PAGES];
+static int atlasPageCount = 0;
+
+// Tri par hauteur décroissante : les étagères se remplissent mieux
+static const SDL_Surface* const* sortSurfaces;
+static int compareHeight(const void* a, const void* b) {
+    int heightA = sortSurfaces[*(const int*)a]->h;
+    int heightB = sortSurfaces[*(const int*)b]->h;
+    if (heightA != heightB) return heightB - heightA;
+    return *(const int*)a - *(const int*)b;
+}
+
+// Rangement en étagères : une ligne se remplit de gauche à droite, puis on
+// passe à la suivante, puis à la page suivante
+static bool packEntries(SDL_Surface** surfaces, int count, int pageSize, int* pageHeights) {
+    int order[MAX_ATLAS_ENTRIES];
+    int sorted = 0;
+    for (int i = 0; i < count; i++) {
+        if (surfaces[i]) order[sorted++] = i;
+    }
+    sortSurfaces = (const SDL_Surface* const*)surfaces;
+    qsort(order, sorted, sizeof(int), compareHeight);
+
+    int page = 0, penX = 0, penY = 0, shelfHeight = 0;
+    pageHeights[0] = 0;
+    for (int k = 0; k < sorted; k++) {
+        int i = order[k];
+        int w = surfaces[i]->w + ATLAS_PADDING;
+        int h = surfaces[i]->h + ATLAS_PADDING;
+        if (w > pageSize || h > pageSize) {
+            printf("Image trop grande pour l'atlas : %s\n", atlasEntries[i].path);
+            continue;
+        }
+        if (penX + w > pageSize) {
+            penX = 0;
+            penY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (penY + h > pageSize) {
+            if (page + 1 >= MAX_ATLAS_PAGES) {
+                atlasPageCount = MAX_ATLAS_PAGES;
+                return false; // Les images restantes gardent page = -1
+            }
+            page++;
+            penX = penY = shelfHeight = 0;
+            pageHeights[page] = 0;
+        }
+        atlasEntries[i].page = page;
+        atlasEntries[i].src = (SDL_Rect){penX, penY, surfaces[i]->w, surfaces[i]->h};
+        penX += w;
+        if (h > shelfHeight) shelfHeight = h;
+        if (penY + h > pageHeights[page]) pageHeights[page] = penY + h;
+    }
+    atlasPageCount = sorted > 0 ? page + 1 : 0;
+    return true;
+}
+
+// Décode toutes les images en parallèle sur les threads du chargeur et les
+// copie dans les pages ; une image absente est simplement ignorée
+// (getAtlasSprite renverra false)
+bool buildAtlas(SDL_Renderer* renderer, const char* const* paths, int count) {
+    SDL_Surface* surfaces[MAX_ATLAS_ENTRIES] = {NULL};
+    AsyncImage* images[MAX_ATLAS_ENTRIES] = {NULL};
+    if (count > MAX_ATLAS_ENTRIES) count = MAX_ATLAS_ENTRIES;
+    cleanupAtlas();
+
+    SDL_RendererInfo info;
+    int pageSize = ATLAS_PAGE_SIZE;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0) {
+        pageSize = SDL_min(pageSize, SDL_min(info.max_texture_width, info.max_texture_height));
+    }
+
+    for (int i = 0; i < count; i++) {
+        atlasEntries[i].path = paths[i];
+        atlasEntries[i].page = -1;
+        images[i] = requestImage(paths[i], false);
+    }
+    for (int i = 0; i < count; i++) {
+        waitForImage(images[i]);
+        if (isImageReady(images[i])) surfaces[i] = images[i]->surface;
+    }
+    atlasEntryCount = count;
+
+    int pageHeights[MAX_ATLAS_PAGES];
+    bool packed = packEntries(surfaces, count, pageSize, pageHeights);
+    if (!packed) printf("Atlas plein, certaines images sont ignorees\n");
+
+    for (int page = 0; page < atlasPageCount; page++) {
+        // Page recadrée à la hauteur réellement utilisée
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageHeights[page], 32, SDL_PIXELFORMAT_RGBA32);
+        if (!pageSurface) continue;
+        SDL_FillRect(pageSurface, NULL, 0);
+        for (int i = 0; i < count; i++) {
+            if (!surfaces[i] || atlasEntries[i].page != page) continue;
+            SDL_Rect dest = atlasEntries[i].src;
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE); // Copie brute, alpha compris
+            // Le blit convertit vers RGBA32 au passage
+            SDL_BlitSurface(surfaces[i], NULL, pageSurface, &dest);
+        }
+        atlasPages[page] = SDL_CreateTextureFromSurface(renderer, pageSurface);
+        SDL_FreeSurface(pageSurface);
+        if (atlasPages[page]) SDL_SetTextureBlendMode(atlasPages[page], SDL_BLENDMODE_BLEND);
+    }
+
+    for (int i = 0; i < count; i++) {
+        releaseImage(images[i]);
+    }
+    return packed;
+}
+
+void cleanupAtlas() {
+    for (int page = 0; page < atlasPageCount; page++) {
+        if (atlasPages[page]) SDL_DestroyTexture(atlasPages[page]);
+        atlasPages[page] = NULL;
+    }
+    atlasPageCount = 0;
+    atlasEntryCount = 0;
+}
+
+bool getAtlasSprite(const char* path, AtlasSprite* sprite) {
+    for (int i = 0; i < atlasEntryCount; i++) {
+        if (strcmp(atlasEntries[i].path, path) != 0) continue;
+        int page = atlasEntries[i].page;
+        if (page < 0 || page >= atlasPageCount || !atlasPages[page]) return false;
+        sprite->texture = atlasPages[page];
+        sprite->src = atlasEntries[i].src;
+        return true;
+    }
+    return false;
+}
+
+int getAtlasPageCount() {
+    return atlasPageCount;
+}
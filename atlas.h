@@ -0,0 +1,26 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+// Atlas d'images : les portraits et icônes sont décodés une seule fois au
+// démarrage et rangés dans une ou deux grandes textures.
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#define MAX_ATLAS_PAGES 2
+#define MAX_ATLAS_ENTRIES 32
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_PADDING 1 // Évite que le filtrage déborde sur l'image voisine
+
+// Emplacement d'une image : texture de la page et rectangle source en pixels
+typedef struct {
+    SDL_Texture* texture;
+    SDL_Rect src;
+} AtlasSprite;
+
+bool buildAtlas(SDL_Renderer* renderer, const char* const* paths, int count);
+void cleanupAtlas();
+bool getAtlasSprite(const char* path, AtlasSprite* sprite);
+int getAtlasPageCount();
+
+#endif
@@ -0,0 +1,274 @@
+// Microbenchmarks des chemins chauds, lancés par `make bench` avec le pilote
+// vidéo factice et le rendu logiciel : aucun écran n'est nécessaire.
+// Utilisation :
+//   ./valobench [--output bench.json] [--baseline bench_baseline.json] [--threshold 10]
+// Chaque mesure est la médiane de BENCH_SAMPLES échantillons d'au moins
+// BENCH_SAMPLE_SECONDS. Avec --baseline, une mesure plus lente que la
+// référence de plus de --threshold % fait échouer la commande.
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "draw.h"
+#include "text.h"
+#include "loader.h"
+#include "sim.h"
+
+#define BENCH_SAMPLES 15
+#define BENCH_SAMPLE_SECONDS 0.02
+#define BENCH_MAX_RESULTS 32
+#define BENCH_SURFACE_WIDTH 800
+#define BENCH_SURFACE_HEIGHT 600
+#define BENCH_SEED 42
+#define BENCH_MANY_BALLS 100000
+#define BENCH_POSITIONS 1024 // Positions parcourues par checkCollision, puissance de 2
+
+typedef void (*BenchFunc)(int iterations);
+
+typedef struct {
+    char name[64];
+    double ns;       // Médiane, en nanosecondes par itération
+    double minNs;
+    int iterations;  // Itérations par échantillon
+} BenchResult;
+
+static SDL_Renderer* renderer = NULL;
+static Simulation simulation;
+static SimRect player = {WORLD_WIDTH / 2 - PLAYER_SIZE / 2, WORLD_HEIGHT / 2 - PLAYER_SIZE / 2, PLAYER_SIZE, PLAYER_SIZE};
+static float positions[BENCH_POSITIONS * 2];
+static const char* imagePath = NULL;
+static volatile int sink; // Empêche le compilateur de supprimer les boucles mesurées
+static BenchResult results[BENCH_MAX_RESULTS];
+static int resultCount = 0;
+
+static void benchInitBalls(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        seedRandom(&simulation, BENCH_SEED + i);
+        initBalls(&simulation);
+    }
+}
+
+static void benchMoveBalls(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        moveBalls(&simulation);
+    }
+}
+
+static void benchCheckCollision(int iterations) {
+    int hits = 0;
+    for (int i = 0; i < iterations; i++) {
+        int index = (i & (BENCH_POSITIONS - 1)) * 2;
+        hits += checkCollision(player, positions[index], positions[index + 1]);
+    }
+    sink = hits;
+}
+
+// Le rendu logiciel met les commandes en file : SDL_RenderFlush les exécute dans la mesure
+static void benchDrawCircle(int iterations) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+    for (int i = 0; i < iterations; i++) {
+        drawCircle(renderer, 100 + i % 600, 300, BALL_RADIUS);
+    }
+    SDL_RenderFlush(renderer);
+}
+
+static void benchDrawRoundedRect(int iterations) {
+    SDL_Rect button = {300, 250, 200, 100};
+    for (int i = 0; i < iterations; i++) {
+        drawRoundedRect(renderer, button, 20, (SDL_Color){0, 0, 255, 255});
+    }
+    SDL_RenderFlush(renderer);
+}
+
+static void benchCreateTextTexture(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        char text[32];
+        snprintf(text, sizeof(text), "Temps: %d s", i % 1000);
+        SDL_Texture* texture = createTextTexture(text, (SDL_Color){255, 255, 255, 255});
+        if (texture) SDL_DestroyTexture(texture);
+    }
+}
+
+// Chemin actuel du chronomètre, pour comparaison : atlas de glyphes déjà rasterisé
+static void benchDrawText(int iterations) {
+    FontAtlas* atlas = getDefaultFont();
+    for (int i = 0; i < iterations; i++) {
+        char text[32];
+        snprintf(text, sizeof(text), "Temps: %d s", i % 1000);
+        drawTextAt(atlas, text, 10, 10, (SDL_Color){255, 255, 255, 255});
+    }
+    SDL_RenderFlush(renderer);
+}
+
+static void benchLoadTexture(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        SDL_Texture* texture = loadTexture(imagePath);
+        if (texture) SDL_DestroyTexture(texture);
+    }
+}
+
+static double sampleSeconds(BenchFunc func, int iterations) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    func(iterations);
+    return (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double left = *(const double*)a, right = *(const double*)b;
+    return (left > right) - (left < right);
+}
+
+static void runBench(const char* name, BenchFunc func) {
+    if (resultCount == BENCH_MAX_RESULTS) return;
+    // Étalonnage : itérations doublées jusqu'à un échantillon assez long pour le compteur
+    int iterations = 1;
+    func(1); // Échauffement (caches, textures de masque, glyphes)
+    while (iterations < (1 << 30) && sampleSeconds(func, iterations) < BENCH_SAMPLE_SECONDS) {
+        iterations *= 2;
+    }
+    double samples[BENCH_SAMPLES];
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = sampleSeconds(func, iterations) * 1e9 / iterations;
+    }
+    qsort(samples, BENCH_SAMPLES, sizeof(double), compareDoubles);
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->ns = samples[BENCH_SAMPLES / 2];
+    result->minNs = samples[0];
+    result->iterations = iterations;
+    printf("%-28s %12.1f ns  (min %.1f, %d iterations)\n", name, result->ns, result->minNs, iterations);
+}
+
+static void runSimulationBenches(int ballCount) {
+    char name[64];
+    if (!simInit(&simulation, ballCount, HARD_SPEED, BENCH_SEED)) return;
+    snprintf(name, sizeof(name), "initBalls/%d", ballCount);
+    runBench(name, benchInitBalls);
+    snprintf(name, sizeof(name), "moveBalls/%d", ballCount);
+    runBench(name, benchMoveBalls);
+    simFree(&simulation);
+}
+
+static void runImageBench(const char* name, const char* path) {
+    imagePath = path;
+    SDL_Texture* texture = loadTexture(path);
+    if (!texture) {
+        printf("%-28s ignore : %s introuvable\n", name, path);
+        return;
+    }
+    SDL_DestroyTexture(texture);
+    runBench(name, benchLoadTexture);
+}
+
+static bool writeResults(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Impossible d'ecrire %s\n", path);
+        return false;
+    }
+    // Une mesure par ligne : relue simplement par compareBaseline
+    fprintf(file, "{\n  \"physics\": \"%s\",\n  \"benchmarks\": [\n", getPhysicsBackendName());
+    for (int i = 0; i < resultCount; i++) {
+        fprintf(file, "    {\"name\": \"%s\", \"ns\": %.3f, \"min_ns\": %.3f, \"iterations\": %d}%s\n",
+                results[i].name, results[i].ns, results[i].minNs, results[i].iterations, i + 1 < resultCount ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+// Renvoie le nombre de régressions, -1 sans référence
+static int compareBaseline(const char* path, double threshold) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("Pas de reference %s : lancer `make bench-baseline` pour en creer une\n", path);
+        return -1;
+    }
+    int regressions = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char physics[16], name[64];
+        double baseline;
+        if (sscanf(line, " \"physics\": \"%15[^\"]\"", physics) == 1 && strcmp(physics, getPhysicsBackendName()) != 0) {
+            printf("Attention : reference mesuree avec la physique %s, pas %s\n", physics, getPhysicsBackendName());
+        }
+        if (sscanf(line, " {\"name\": \"%63[^\"]\", \"ns\": %lf", name, &baseline) != 2 || baseline <= 0) continue;
+        for (int i = 0; i < resultCount; i++) {
+            if (strcmp(results[i].name, name) != 0) continue;
+            double change = (results[i].ns / baseline - 1.0) * 100.0;
+            const char* verdict = "";
+            if (change > threshold) {
+                verdict = "  REGRESSION";
+                regressions++;
+            } else if (change < -threshold) {
+                verdict = "  amelioration";
+            }
+            printf("%-28s %+7.1f %%%s\n", name, change, verdict);
+        }
+    }
+    fclose(file);
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    const char* outputPath = "bench.json";
+    const char* baselinePath = NULL;
+    double threshold = 10.0; // Pourcentage de ralentissement toléré
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        }
+    }
+
+    // Rendu logiciel dans une surface : identique d'une machine à l'autre, sans GPU
+    if (SDL_Init(SDL_INIT_VIDEO) < 0 || IMG_Init(IMG_INIT_PNG) == 0 || TTF_Init() == -1) {
+        printf("Erreur d'initialisation: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, BENCH_SURFACE_WIDTH, BENCH_SURFACE_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    renderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    if (!renderer || !initText(renderer) || !initLoader(renderer)) {
+        printf("Erreur de création du renderer logiciel : %s\n", SDL_GetError());
+        return 1;
+    }
+    printf("Pilote video %s, physique %s\n", SDL_GetCurrentVideoDriver(), getPhysicsBackendName());
+
+    // Simulation : un seul thread, le pool de jobs n'est pas démarré
+    runSimulationBenches(HARD_BALLS);
+    runSimulationBenches(BENCH_MANY_BALLS);
+    Simulation random; // Seul le générateur sert : mêmes positions à chaque lancement
+    seedRandom(&random, BENCH_SEED);
+    for (int i = 0; i < BENCH_POSITIONS * 2; i += 2) {
+        positions[i] = (float)(nextRandom(&random) % WORLD_WIDTH);
+        positions[i + 1] = (float)(nextRandom(&random) % WORLD_HEIGHT);
+    }
+    runBench("checkCollision", benchCheckCollision);
+
+    runBench("drawCircle", benchDrawCircle);
+    runBench("drawRoundedRect", benchDrawRoundedRect);
+    runBench("createTextTexture", benchCreateTextTexture);
+    runBench("drawText", benchDrawText);
+    runImageBench("loadTexture/Smoke", "Smoke.png");
+    runImageBench("loadTexture/background", "background.png");
+
+    bool written = writeResults(outputPath);
+    if (written) printf("Resultats : %s\n", outputPath);
+    int regressions = baselinePath ? compareBaseline(baselinePath, threshold) : -1;
+    if (regressions > 0) printf("%d regression(s) au-dela de %.0f %%\n", regressions, threshold);
+
+    cleanupLoader();
+    cleanupDraw();
+    cleanupText();
+    cleanupResources();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return !written || regressions > 0 ? 1 : 0;
+}
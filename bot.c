@@ -0,0 +1,312 @@
+#include "bot.h"
+#include "input.h"
+#include "loader.h"
+#include "resource.h"
+#include "timing.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#define BOT_CANDIDATES 9
+#define BOT_CENTER_WEIGHT 0.05f // Sans danger proche, le bot revient vers le centre
+#define BOT_KEEP_BONUS 1.0f     // Évite d'hésiter entre deux directions équivalentes
+#define BOT_MAX_THREATS 64      // Balles dont la trajectoire est prolongée à chaque frame
+
+// Directions essayées à chaque frame, tenues pendant tout l'horizon
+static const SimInput candidates[BOT_CANDIDATES] = {
+    0, INPUT_UP, INPUT_DOWN, INPUT_LEFT, INPUT_RIGHT,
+    INPUT_UP | INPUT_LEFT, INPUT_UP | INPUT_RIGHT, INPUT_DOWN | INPUT_LEFT, INPUT_DOWN | INPUT_RIGHT
+};
+
+static bool active = false;
+static int durationMinutes = 0;
+static Uint64 startCounter = 0;
+static Uint32 lastAction = 0;
+static Uint64 randomState = 0;
+static SimInput previousInput = 0;
+static int rounds = 0;
+static Uint64 survivedSeconds = 0;
+
+// Mesures de l'intervalle en cours, publiées puis remises à zéro
+static FILE* reportFile = NULL;
+static double frameMs[BOT_MAX_FRAME_SAMPLES];
+static int frameSamples = 0;
+static double slowestMs = 0.0; // Compte aussi les frames au-delà de BOT_MAX_FRAME_SAMPLES
+static Uint64 intervalFrames = 0;
+static Uint64 intervalStart = 0;
+static Uint64 lastFrame = 0;
+static int reportCount = 0;
+static long firstResidentKb = -1;
+static long lastResidentKb = 0;
+static double firstP99 = 0.0;
+static double lastP99 = 0.0;
+
+// Joueur déplacé comme par movePlayer (sim.c)
+static SimRect movePlayerRect(SimRect player, SimInput input) {
+    if ((input & INPUT_UP) && player.y > 0) player.y -= PLAYER_SPEED;
+    if ((input & INPUT_DOWN) && player.y + player.h < WORLD_HEIGHT) player.y += PLAYER_SPEED;
+    if ((input & INPUT_LEFT) && player.x > 0) player.x -= PLAYER_SPEED;
+    if ((input & INPUT_RIGHT) && player.x + player.w < WORLD_WIDTH) player.x += PLAYER_SPEED;
+    return player;
+}
+
+// Distance entre le bord de la balle et le rectangle du joueur, négative en cas de contact
+static float clearanceOf(SimRect player, float x, float y) {
+    float dx = fmaxf(fmaxf(player.x - x, 0.0f), x - (player.x + player.w));
+    float dy = fmaxf(fmaxf(player.y - y, 0.0f), y - (player.y + player.h));
+    return sqrtf(dx * dx + dy * dy) - BALL_RADIUS;
+}
+
+// Rebond d'une balle sur un axe, copie de moveBallRange (physics.c) : simple
+// changement de signe en mode normal, balle ramenée dans le monde avec les chocs
+static void bounceAxis(float* position, float* velocity, float limit, bool contain) {
+    if (!contain) {
+        if (*position - BALL_RADIUS <= 0 || *position + BALL_RADIUS >= limit) *velocity = -*velocity;
+    } else if (*position - BALL_RADIUS <= 0) {
+        *position = BALL_RADIUS;
+        *velocity = fabsf(*velocity);
+    } else if (*position + BALL_RADIUS >= limit) {
+        *position = limit - BALL_RADIUS;
+        *velocity = -fabsf(*velocity);
+    }
+}
+
+// Politique d'esquive : chaque direction candidate est tenue BOT_HORIZON_TICKS
+// pas pendant que les balles proches suivent leur trajectoire actuelle, rebonds
+// compris ; la direction gardant la plus grande marge minimale l'emporte. Les
+// chocs entre balles (--collisions) ne sont pas anticipés.
+static SimInput steer(const Simulation* sim) {
+    if (sim->over) return 0;
+    SimRect paths[BOT_CANDIDATES][BOT_HORIZON_TICKS];
+    float clearance[BOT_CANDIDATES];
+    for (int c = 0; c < BOT_CANDIDATES; c++) {
+        SimRect player = sim->player;
+        for (int t = 0; t < BOT_HORIZON_TICKS; t++) {
+            player = movePlayerRect(player, candidates[c]);
+            paths[c][t] = player;
+        }
+        clearance[c] = BOT_SAFE_DISTANCE;
+    }
+
+    // Balles les plus proches seulement, triées par distance : en mode stress,
+    // le coût reste celui de BOT_MAX_THREATS trajectoires
+    const BallArrays* balls = &sim->balls;
+    float centerX = sim->player.x + sim->player.w / 2.0f;
+    float centerY = sim->player.y + sim->player.h / 2.0f;
+    int threats[BOT_MAX_THREATS];
+    float threatDistance[BOT_MAX_THREATS];
+    int threatCount = 0;
+    for (int i = 0; i < sim->ballCount; i++) {
+        float dx = balls->dx[i], dy = balls->dy[i];
+        float distance = fabsf(balls->x[i] - centerX) + fabsf(balls->y[i] - centerY);
+        // Trop loin pour approcher pendant l'horizon
+        float reach = BOT_HORIZON_TICKS * (fabsf(dx) + fabsf(dy) + 2 * PLAYER_SPEED) + BOT_SAFE_DISTANCE + PLAYER_SIZE + BALL_RADIUS;
+        if (distance > reach) continue;
+        if (threatCount == BOT_MAX_THREATS && distance >= threatDistance[threatCount - 1]) continue;
+        int slot = threatCount < BOT_MAX_THREATS ? threatCount++ : BOT_MAX_THREATS - 1;
+        while (slot > 0 && threatDistance[slot - 1] > distance) {
+            threats[slot] = threats[slot - 1];
+            threatDistance[slot] = threatDistance[slot - 1];
+            slot--;
+        }
+        threats[slot] = i;
+        threatDistance[slot] = distance;
+    }
+
+    for (int n = 0; n < threatCount; n++) {
+        int i = threats[n];
+        float x = balls->x[i], y = balls->y[i];
+        float dx = balls->dx[i], dy = balls->dy[i];
+        for (int t = 0; t < BOT_HORIZON_TICKS; t++) {
+            // Même ordre que moveBallRange (physics.c) : déplacement puis rebond
+            x += dx;
+            y += dy;
+            bounceAxis(&x, &dx, WORLD_WIDTH, sim->ballCollisions);
+            bounceAxis(&y, &dy, WORLD_HEIGHT, sim->ballCollisions);
+            for (int c = 0; c < BOT_CANDIDATES; c++) {
+                float distance = clearanceOf(paths[c][t], x, y);
+                if (distance < clearance[c]) clearance[c] = distance;
+            }
+        }
+    }
+
+    // Au-delà de BOT_ROUND_SECONDS, le bot va au contact : chaque partie finit
+    bool givingUp = sim->tick >= (uint32_t)BOT_ROUND_SECONDS * TICK_RATE;
+    int best = 0;
+    float bestScore = -INFINITY;
+    for (int c = 0; c < BOT_CANDIDATES; c++) {
+        const SimRect* end = &paths[c][BOT_HORIZON_TICKS - 1];
+        float offsetX = end->x + end->w / 2.0f - WORLD_WIDTH / 2.0f;
+        float offsetY = end->y + end->h / 2.0f - WORLD_HEIGHT / 2.0f;
+        float score = givingUp ? -clearance[c] : clearance[c] - BOT_CENTER_WEIGHT * sqrtf(offsetX * offsetX + offsetY * offsetY);
+        if (candidates[c] == previousInput) score += BOT_KEEP_BONUS;
+        if (score > bestScore) {
+            bestScore = score;
+            best = c;
+        }
+    }
+    previousInput = candidates[best];
+    return previousInput;
+}
+
+// Mémoire résidente actuelle en Ko ; sans /proc (macOS), seulement le pic
+static long readResidentKb() {
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file) {
+        long size, resident;
+        int read = fscanf(file, "%ld %ld", &size, &resident);
+        fclose(file);
+        if (read == 2) return resident * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // En octets sur macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static int compareMs(const void* a, const void* b) {
+    double left = *(const double*)a, right = *(const double*)b;
+    return (left > right) - (left < right);
+}
+
+// Une ligne par intervalle, à l'écran et dans BOT_REPORT_PATH
+static void publishReport(Uint64 now) {
+    if (frameSamples == 0) return;
+    qsort(frameMs, frameSamples, sizeof(double), compareMs);
+    double p50 = frameMs[(frameSamples - 1) * 50 / 100];
+    double p95 = frameMs[(frameSamples - 1) * 95 / 100];
+    double p99 = frameMs[(frameSamples - 1) * 99 / 100];
+    long residentKb = readResidentKb();
+    if (firstResidentKb < 0) {
+        firstResidentKb = residentKb;
+        firstP99 = p99;
+    }
+    lastResidentKb = residentKb;
+    lastP99 = p99;
+    reportCount++;
+
+    double minutes = (double)(now - startCounter) / SDL_GetPerformanceFrequency() / 60.0;
+    int imageTextures = getImageTextureCount();
+    int uiTextures = getUiTextureCount();
+    printf("Bot %.1f min : %d partie(s), %llu images, p50 %.1f ms p95 %.1f ms p99 %.1f ms max %.1f ms, "
+           "RSS %ld Ko (%+ld), textures %d images + %d interface, %d chargement(s)\n",
+           minutes, rounds, (unsigned long long)intervalFrames, p50, p95, p99, slowestMs,
+           residentKb, residentKb - firstResidentKb, imageTextures, uiTextures, getResourceLoadCount());
+    if (reportFile) {
+        fprintf(reportFile, "%.2f,%d,%llu,%.3f,%.3f,%.3f,%.3f,%ld,%d,%d,%d\n", minutes, rounds,
+                (unsigned long long)intervalFrames, p50, p95, p99, slowestMs, residentKb, imageTextures, uiTextures,
+                getResourceLoadCount());
+        fflush(reportFile); // Lisible pendant l'essai, et complet même si le jeu est tué
+    }
+
+    frameSamples = 0;
+    slowestMs = 0.0;
+    intervalFrames = 0;
+    intervalStart = now;
+}
+
+void startBot(int minutes) {
+    active = true;
+    durationMinutes = minutes;
+    startCounter = SDL_GetPerformanceCounter();
+    intervalStart = startCounter;
+    lastAction = SDL_GetTicks();
+    randomState = startCounter | 1;
+    setInputSource(steer);
+    reportFile = fopen(BOT_REPORT_PATH, "w");
+    if (reportFile) {
+        fprintf(reportFile, "minutes,parties,images,p50_ms,p95_ms,p99_ms,max_ms,rss_kb,textures_images,textures_interface,chargements\n");
+    } else {
+        printf("Impossible d'ecrire %s, mesures a l'ecran seulement\n", BOT_REPORT_PATH);
+    }
+    if (minutes > 0) {
+        printf("Bot actif pour %d min, mesures toutes les %d s\n", minutes, BOT_REPORT_SECONDS);
+    } else {
+        printf("Bot actif sans limite, mesures toutes les %d s\n", BOT_REPORT_SECONDS);
+    }
+}
+
+// Dernier intervalle incomplet, puis bilan de toute la session
+void stopBot() {
+    if (!active) return;
+    publishReport(SDL_GetPerformanceCounter());
+    if (reportCount > 0) {
+        printf("Bot : %d partie(s), survie moyenne %.1f s, RSS %+ld Ko et p99 %.1f -> %.1f ms depuis la premiere mesure\n",
+               rounds, rounds > 0 ? (double)survivedSeconds / rounds : 0.0, lastResidentKb - firstResidentKb,
+               firstP99, lastP99);
+    }
+    if (reportFile) {
+        fclose(reportFile);
+        reportFile = NULL;
+        printf("Mesures : %s\n", BOT_REPORT_PATH);
+    }
+    setInputSource(NULL);
+    active = false;
+}
+
+bool isBotActive() {
+    return active;
+}
+
+// Durée écoulée : le bot quitte au prochain passage par le menu
+bool isBotFinished() {
+    if (!active || durationMinutes <= 0) return false;
+    Uint64 elapsed = SDL_GetPerformanceCounter() - startCounter;
+    return elapsed >= (Uint64)durationMinutes * 60 * SDL_GetPerformanceFrequency();
+}
+
+// Appelé une fois par frame par chaque écran : true quand il est temps de cliquer
+bool botReady() {
+    if (!active || SDL_GetTicks() - lastAction < BOT_ACTION_MS) return false;
+    lastAction = SDL_GetTicks();
+    return true;
+}
+
+static void clickCenter(SDL_Rect rect) {
+    pushClick(rect.x + rect.w / 2, rect.y + rect.h / 2);
+}
+
+void botClick(Ui* ui, int id) {
+    Widget* widget = uiFind(ui, id);
+    if (widget && widget->visible) clickCenter(widget->def.rect);
+}
+
+void botClickCell(Ui* ui, int id, int cell) {
+    clickCenter(uiGetCellRect(ui, id, cell));
+}
+
+// Choix uniforme dans [0, count), indépendant du générateur de la simulation
+int botChoose(int count) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return count > 0 ? (int)(randomState % (Uint64)count) : 0;
+}
+
+// Appelé à chaque image affichée : temps écoulé depuis la précédente
+void botFrame() {
+    if (!active) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastFrame != 0) {
+        double ms = (double)(now - lastFrame) * 1000.0 / SDL_GetPerformanceFrequency();
+        if (frameSamples < BOT_MAX_FRAME_SAMPLES) frameMs[frameSamples++] = ms;
+        if (ms > slowestMs) slowestMs = ms;
+        intervalFrames++;
+    }
+    lastFrame = now;
+    if (now - intervalStart >= (Uint64)BOT_REPORT_SECONDS * SDL_GetPerformanceFrequency()) {
+        publishReport(now);
+    }
+}
+
+void botGameOver(Uint32 elapsed) {
+    if (!active) return;
+    rounds++;
+    survivedSeconds += elapsed;
+    lastAction = SDL_GetTicks(); // L'écran de fin reste affiché BOT_ACTION_MS
+}
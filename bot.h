@@ -0,0 +1,36 @@
+#ifndef BOT_H
+#define BOT_H
+
+// Joueur automatique pour les essais d'endurance (--bot, make soak). Il
+// traverse les menus par des clics synthétiques au centre des widgets,
+// esquive les balles en prolongeant leur trajectoire, et publie toutes les
+// BOT_REPORT_SECONDS les percentiles du temps de frame, la mémoire résidente
+// et le nombre de textures vivantes : une fuite lente ou une dérive du temps
+// de frame apparaît au fil des lignes. Prévu pour tourner des heures avec
+// SDL_VIDEODRIVER=dummy et SDL_AUDIODRIVER=dummy.
+
+#include <SDL.h>
+#include <stdbool.h>
+#include "ui.h"
+#include "sim.h"
+
+#define BOT_ACTION_MS 400          // Délai entre deux clics : chaque écran est affiché un moment
+#define BOT_HORIZON_TICKS 24       // Pas anticipés pour chaque direction candidate
+#define BOT_SAFE_DISTANCE 120.0f   // Marge au-delà de laquelle une balle est ignorée
+#define BOT_ROUND_SECONDS 90       // Temps de jeu après lequel le bot cherche la collision
+#define BOT_REPORT_SECONDS 60
+#define BOT_MAX_FRAME_SAMPLES 65536 // Temps de frame gardés par intervalle de mesure
+#define BOT_REPORT_PATH "bot.csv"
+
+void startBot(int minutes); // 0 : sans limite de durée
+void stopBot();
+bool isBotActive();
+bool isBotFinished();
+bool botReady();
+void botClick(Ui* ui, int id);
+void botClickCell(Ui* ui, int id, int cell);
+int botChoose(int count);
+void botFrame();
+void botGameOver(Uint32 elapsed);
+
+#endif
@@ -0,0 +1,106 @@
+#include "draw.h"
+#include <math.h>
+
+typedef struct {
+    int radius;
+    SDL_Texture* texture;
+} CircleMask;
+
+static SDL_Renderer* maskRenderer = NULL;
+static CircleMask circleMasks[MAX_CIRCLE_MASKS];
+static int circleMaskCount = 0;
+
+void cleanupDraw() {
+    for (int i = 0; i < circleMaskCount; i++) {
+        SDL_DestroyTexture(circleMasks[i].texture);
+    }
+    circleMaskCount = 0;
+    maskRenderer = NULL;
+}
+
+// Demi-largeur de la ligne dy du disque : couvre les mêmes pixels que
+// l'ancienne boucle point par point (dx dans ]-radius, radius])
+static void circleSpan(int radius, int dy, int* minDx, int* maxDx) {
+    int halfWidth = (int)sqrt((double)(radius * radius - dy * dy));
+    while ((halfWidth + 1) * (halfWidth + 1) + dy * dy <= radius * radius) halfWidth++;
+    while (halfWidth * halfWidth + dy * dy > radius * radius) halfWidth--;
+    *minDx = SDL_max(-halfWidth, 1 - radius);
+    *maxDx = SDL_min(halfWidth, radius);
+}
+
+// Rasterise une fois un disque blanc de rayon donné, teinté ensuite par color mod
+static SDL_Texture* getCircleMask(SDL_Renderer* renderer, int radius) {
+    if (maskRenderer && maskRenderer != renderer) return NULL;
+    for (int i = 0; i < circleMaskCount; i++) {
+        if (circleMasks[i].radius == radius) return circleMasks[i].texture;
+    }
+    if (circleMaskCount >= MAX_CIRCLE_MASKS || radius > MAX_MASK_RADIUS) return NULL;
+
+    int size = radius * 2;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) return NULL;
+    SDL_FillRect(surface, NULL, 0);
+    for (int dy = 1 - radius; dy <= radius; dy++) {
+        int minDx, maxDx;
+        circleSpan(radius, dy, &minDx, &maxDx);
+        Uint32* row = (Uint32*)((Uint8*)surface->pixels + (dy + radius - 1) * surface->pitch);
+        for (int dx = minDx; dx <= maxDx; dx++) {
+            row[dx + radius - 1] = 0xFFFFFFFF;
+        }
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!texture) return NULL;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    maskRenderer = renderer;
+    circleMasks[circleMaskCount].radius = radius;
+    circleMasks[circleMaskCount].texture = texture;
+    circleMaskCount++;
+    return texture;
+}
+
+// Repli sans cache : une ligne horizontale par rangée, envoyées en un seul appel
+static void fillCircleSpans(SDL_Renderer* renderer, int centerX, int centerY, int radius) {
+    SDL_Rect spans[MAX_SPAN_ROWS];
+    int spanCount = 0;
+    for (int dy = 1 - radius; dy <= radius; dy++) {
+        int minDx, maxDx;
+        circleSpan(radius, dy, &minDx, &maxDx);
+        spans[spanCount++] = (SDL_Rect){centerX + minDx, centerY + dy, maxDx - minDx + 1, 1};
+        if (spanCount == MAX_SPAN_ROWS) {
+            SDL_RenderFillRects(renderer, spans, spanCount);
+            spanCount = 0;
+        }
+    }
+    if (spanCount > 0) SDL_RenderFillRects(renderer, spans, spanCount);
+}
+
+void drawCircle(SDL_Renderer* renderer, int centerX, int centerY, int radius) {
+    if (radius <= 0) return;
+    SDL_Texture* mask = getCircleMask(renderer, radius);
+    if (!mask) {
+        fillCircleSpans(renderer, centerX, centerY, radius);
+        return;
+    }
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetTextureColorMod(mask, r, g, b);
+    SDL_SetTextureAlphaMod(mask, a);
+    SDL_Rect dest = {centerX - radius + 1, centerY - radius + 1, radius * 2, radius * 2};
+    SDL_RenderCopy(renderer, mask, NULL, &dest);
+}
+
+void drawRoundedRect(SDL_Renderer* renderer, SDL_Rect rect, int radius, SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+    drawCircle(renderer, rect.x + radius, rect.y + radius, radius);
+    drawCircle(renderer, rect.x + rect.w - radius, rect.y + radius, radius);
+    drawCircle(renderer, rect.x + radius, rect.y + rect.h - radius, radius);
+    drawCircle(renderer, rect.x + rect.w - radius, rect.y + rect.h - radius, radius);
+    SDL_Rect fills[3] = {
+        {rect.x + radius, rect.y, rect.w - 2 * radius, rect.h},             // Bande centrale
+        {rect.x, rect.y + radius, radius, rect.h - 2 * radius},             // Gauche
+        {rect.x + rect.w - radius, rect.y + radius, radius, rect.h - 2 * radius} // Droite
+    };
+    SDL_RenderFillRects(renderer, fills, 3);
+}
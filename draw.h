@@ -0,0 +1,14 @@
+#ifndef DRAW_H
+#define DRAW_H
+
+#include <SDL.h>
+
+#define MAX_CIRCLE_MASKS 16
+#define MAX_MASK_RADIUS 128  // Au-delà, les disques sont tracés par lignes
+#define MAX_SPAN_ROWS 256
+
+void cleanupDraw();
+void drawCircle(SDL_Renderer* renderer, int centerX, int centerY, int radius);
+void drawRoundedRect(SDL_Renderer* renderer, SDL_Rect rect, int radius, SDL_Color color);
+
+#endif
@@ -2,55 +2,74 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
-#include <mysql/mysql.h>
 #include <stdbool.h>
 #include <time.h>
 #include <math.h>
-#include <sqlite3.h>
-
-
-#define SCREEN_WIDTH 800
-#define SCREEN_HEIGHT 600
-#define PLAYER_SPEED 5
-#define BALL_RADIUS 20
-#define EASY_BALLS 3
-#define MEDIUM_BALLS 6
-#define HARD_BALLS 9
-#define EASY_SPEED 3
-#define MEDIUM_SPEED 4
-#define HARD_SPEED 5
+#include "text.h"
+#include "draw.h"
+#include "ui.h"
+#include "timing.h"
+#include "sprite.h"
+#include "atlas.h"
+#include "resource.h"
+#include "pack.h"
+#include "scores.h"
+#include "sim.h"
+#include "replay.h"
+#include "profile.h"
+#include "input.h"
+#include "bot.h"
+#include "scene.h"
+
+
+#define SCREEN_WIDTH WORLD_WIDTH
+#define SCREEN_HEIGHT WORLD_HEIGHT
 #define CHARACTERS_PER_ROW 4
 #define CHARACTER_SIZE 80
 #define CHARACTER_PADDING 20
+#define REPLAY_SEEK_TICKS (TICK_RATE * 10) // Saut des flèches gauche/droite pendant un replay
+#define REPLAY_STEP_BUDGET 0.012 // Secondes de simulation par image en vitesse maximale
 
-int currentBallCount = EASY_BALLS;
-int currentBallSpeed = EASY_SPEED;
-
-typedef struct {
-    int x, y; // Position du centre
-    int dx, dy; // Vitesse
-} Ball;
-
-typedef struct {
-    int id;
-    char nom[50];
-    int time;
-    char difficulte[20];  // Nouveau champ pour la difficulté
-} Score;
+Difficulty currentDifficulty = DIFFICULTY_EASY;
+const char* difficultyNames[DIFFICULTY_COUNT] = {"Facile", "Intermediaire", "Difficile"};
 
 SDL_Window* window = NULL;
 SDL_Renderer* renderer = NULL;
-SDL_Texture* playerTexture = NULL;
-SDL_Texture* backgroundTexture = NULL; // Texture du fond
-SDL_Texture* menuBackgroundTexture = NULL; // Texture du fond du menu
-SDL_Texture* ballTexture = NULL; // Nouvelle texture pour les balles
-SDL_Rect player;
-Ball* balls = NULL; // Tableau dynamique de balles
-Uint32 startTime;
-Score topScores[10];
+// Textures partagées par les écrans de menu, acquises une fois dans main
+Resource* playerTexture = NULL;
+Resource* menuBackgroundTexture = NULL; // Texture du fond du menu
+Simulation simulation; // État de la partie en cours
+int stressBallCount = 0; // --balls N : remplace le nombre de balles de la difficulté
+bool ballCollisionMode = false; // --collisions : chocs élastiques entre balles
+
+// Les parties aux réglages modifiés (--balls, --collisions) ne vont pas au classement
+static bool isRankedGame() {
+    return stressBallCount == 0 && !ballCollisionMode;
+}
+Score topScores[TOP_SCORE_COUNT];
+int topScoreCount = 0;
 
 char selectedCharacter[256] = "user/phoenix.png"; // Variable globale pour stocker le personnage sélectionné
 
+// Ressources propres à certains écrans, acquises à l'entrée et libérées à la sortie
+static const ResourceDef tutorialResources[] = {
+    {RESOURCE_TEXTURE, "assets/arrow_keys.png"}
+};
+enum { GAME_BACKGROUND, GAME_BALL };
+static const ResourceDef gameResources[] = {
+    {RESOURCE_TEXTURE, "background.png"},
+    {RESOURCE_TEXTURE, "Smoke.png"}
+};
+enum { AUDIO_MUSIC, AUDIO_SELECT, AUDIO_COLLISION, AUDIO_BUTTON, AUDIO_PAUSE };
+static const ResourceDef audioResources[] = {
+    {RESOURCE_MUSIC, "sounds/background.mp3"},
+    {RESOURCE_CHUNK, "sounds/select.wav"},
+    {RESOURCE_CHUNK, "sounds/collision.wav"},
+    {RESOURCE_CHUNK, "sounds/button.wav"},
+    {RESOURCE_CHUNK, "sounds/pause.wav"}
+};
+static Resource* audio[SDL_arraysize(audioResources)];
+
 // Variables globales pour l'audio
 Mix_Music* backgroundMusic = NULL;
 Mix_Chunk* selectSound = NULL;
@@ -59,17 +78,18 @@ Mix_Chunk* buttonSound = NULL;
 Mix_Chunk* pauseSound = NULL;
 
 void initAudio() {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    if (Mix_OpenAudio(PACK_AUDIO_FREQUENCY, PACK_AUDIO_FORMAT, PACK_AUDIO_CHANNELS, 2048) < 0) {
         printf("Erreur d'initialisation de SDL_mixer: %s\n", Mix_GetError());
         return;
     }
 
     // Charger les sons
-    backgroundMusic = Mix_LoadMUS("sounds/background.mp3");
-    selectSound = Mix_LoadWAV("sounds/select.wav");
-    collisionSound = Mix_LoadWAV("sounds/collision.wav");
-    buttonSound = Mix_LoadWAV("sounds/button.wav");
-    pauseSound = Mix_LoadWAV("sounds/pause.wav");
+    acquireResourceSet(audioResources, SDL_arraysize(audioResources), audio);
+    backgroundMusic = getMusic(audio[AUDIO_MUSIC]);
+    selectSound = getChunk(audio[AUDIO_SELECT]);
+    collisionSound = getChunk(audio[AUDIO_COLLISION]);
+    buttonSound = getChunk(audio[AUDIO_BUTTON]);
+    pauseSound = getChunk(audio[AUDIO_PAUSE]);
 
     // Vérifier le chargement des sons
     if (!backgroundMusic || !selectSound || !collisionSound || !buttonSound || !pauseSound) {
@@ -82,1225 +102,830 @@ void initAudio() {
 }
 
 void cleanupAudio() {
-    if (backgroundMusic) Mix_FreeMusic(backgroundMusic);
-    if (selectSound) Mix_FreeChunk(selectSound);
-    if (collisionSound) Mix_FreeChunk(collisionSound);
-    if (buttonSound) Mix_FreeChunk(buttonSound);
-    if (pauseSound) Mix_FreeChunk(pauseSound);
+    Mix_HaltMusic();
+    releaseResourceSet(audio, SDL_arraysize(audioResources));
+    cleanupResources(); // Vide tout le cache, sons compris, avant de fermer le périphérique
     Mix_CloseAudio();
 }
 
-void finish_with_error(MYSQL *con) {
-    fprintf(stderr, "%s\n", mysql_error(con));
-    mysql_close(con);
-    exit(1);
+// Écrans du jeu, enchaînés par le gestionnaire de scènes (scene.h) : aucun
+// ne rappelle le précédent, une partie de plus n'ajoute rien à la pile
+static const Scene menuScene, scoresScene, characterScene, difficultyScene, tutorialScene,
+    gameScene, pauseScene, gameOverScene, replayScene;
+
+void displayTime(Uint32 elapsed) {
+    PROFILE_SCOPE("displayTime");
+    static DynamicText timeText;
+    if (!timeText.atlas) {
+        SDL_Color textColor = {255, 255, 255}; // Blanc
+        SDL_Rect timeRect = {10, 10, 100, 50}; // Position en haut à gauche
+        initDynamicText(&timeText, getDefaultFont(), timeRect, textColor);
+    }
+    // Les sommets ne sont reconstruits qu'une fois par seconde
+    setDynamicText(&timeText, "Temps: %u s", elapsed);
+    drawDynamicText(&timeText);
 }
 
-void createDatabase(MYSQL *con) {
-    // Vérifier si la base de données existe, la créer si nécessaire
-    if (mysql_query(con, "CREATE DATABASE IF NOT EXISTS game_db")) {
-        finish_with_error(con);
-    }
-    // Utiliser la base de données
-    if (mysql_query(con, "USE game_db")) {
-        finish_with_error(con);
-    }
-    printf("Base de données 'game_db' sélectionnée.\n");
-}
+enum { GAMEOVER_NAME_LABEL = 1, GAMEOVER_NAME, GAMEOVER_TIME, GAMEOVER_BACK, GAMEOVER_RANK };
 
-void getTopScores(MYSQL *con, const char* difficulte) {
-    char query[200];
-    sprintf(query, "SELECT * FROM Scores WHERE Difficulte = '%s' ORDER BY Time DESC LIMIT 10", difficulte);
-    if (mysql_query(con, query)) {
-        finish_with_error(con);
-    }
+static const WidgetDef gameOverWidgets[] = {
+    UI_LABEL(GAMEOVER_NAME_LABEL, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 150, 200, 50, "Entrez votre nom:"),
+    {.type = WIDGET_TEXT_FIELD, .id = GAMEOVER_NAME, .rect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 100, 200, 50}},
+    {.type = WIDGET_LABEL, .id = GAMEOVER_TIME, .rect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50}, .flags = UI_DYNAMIC},
+    UI_BUTTON(GAMEOVER_BACK, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 10, 200, 100, "Retour au menu", 50, 25, 100, 50),
+    {.type = WIDGET_LABEL, .id = GAMEOVER_RANK, .rect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 120, 200, 50},
+     .flags = UI_DYNAMIC | UI_HIDDEN}
+};
 
-    MYSQL_RES *result = mysql_store_result(con);
-    if (result == NULL) {
-        finish_with_error(con);
-    }
+static Ui gameOverUi;
+static Uint32 gameOverElapsed = 0; // Temps de survie, fixé par la partie avant le changement d'écran
 
-    int num_fields = mysql_num_fields(result);
-    MYSQL_ROW row;
-
-    int i = 0;
-    while ((row = mysql_fetch_row(result)) && i < 10) {
-        topScores[i].id = atoi(row[0]);
-        strncpy(topScores[i].nom, row[1], 49);
-        topScores[i].nom[49] = '\0';
-        topScores[i].time = atoi(row[2]);
-        strncpy(topScores[i].difficulte, row[3], 19);
-        topScores[i].difficulte[19] = '\0';
-        i++;
-    }
+static bool enterGameOver() {
+    uiLoad(&gameOverUi, gameOverWidgets, SDL_arraysize(gameOverWidgets));
+    uiSetText(&gameOverUi, GAMEOVER_TIME, "Perdu! Temps: %u s", gameOverElapsed);
 
-    // Remplir le reste du tableau avec des scores vides si nécessaire
-    for (; i < 10; i++) {
-        topScores[i].id = 0;
-        topScores[i].nom[0] = '\0';
-        topScores[i].time = 0;
-        topScores[i].difficulte[0] = '\0';
+    // Rang qu'obtiendrait ce temps, lu en mémoire : aucune requête ici
+    int rank, total;
+    if (isRankedGame() && getScoreRank(difficultyNames[currentDifficulty], gameOverElapsed, &rank, &total)) {
+        uiSetText(&gameOverUi, GAMEOVER_RANK, "Classement : #%d sur %d", rank, total + 1);
+        uiSetVisible(&gameOverUi, GAMEOVER_RANK, true);
     }
-
-    mysql_free_result(result);
+    return true;
 }
 
-SDL_Texture* loadTexture(const char* path);
-SDL_Texture* createTextTexture(const char* text, SDL_Color color);
-void drawCircle(SDL_Renderer* renderer, int centerX, int centerY, int radius);
-bool checkCollision(SDL_Rect a, Ball ball);
-void initBalls();
-void moveBalls();
-void drawRoundedRect(SDL_Renderer* renderer, SDL_Rect rect, int radius, SDL_Color color);
-void displayTime(Uint32 startTime);
-void displayGameOver(Uint32 startTime);
-void displayMenu();
-void startGame();
-void displayScores();
-void insertScore(MYSQL *con, const char* nom, int time, const char* difficulte);
-void selectDifficulty();
-void selectCharacter();
-void displayPauseMenu();
-void displayTutorial();
-
-SDL_Texture* loadTexture(const char* path) {
-    SDL_Surface* surface = IMG_Load(path);
-    if (!surface) {
-        printf("Erreur de chargement d'image : %s\n", IMG_GetError());
-        return NULL;
+static void handleGameOverEvent(const SDL_Event* event) {
+    switch (uiHandleEvent(&gameOverUi, event)) {
+        case GAMEOVER_BACK:
+            switchScene(&menuScene);
+            break;
+        case GAMEOVER_NAME:
+            if (!isRankedGame()) {
+                switchScene(&menuScene);
+            } else if (strlen(uiGetText(&gameOverUi, GAMEOVER_NAME)) > 0) {
+                submitScore(uiGetText(&gameOverUi, GAMEOVER_NAME), gameOverElapsed, difficultyNames[currentDifficulty]);
+                switchScene(&menuScene);
+            }
+            break;
     }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    return texture;
 }
 
-SDL_Texture* createTextTexture(const char* text, SDL_Color color) {
-    TTF_Font* font = TTF_OpenFont("KOMIKAX_.ttf", 24); // Ajuste le chemin et la taille de la police ici
-    if (!font) {
-        printf("Erreur de chargement de la police : %s\n", TTF_GetError());
-        return NULL;
-    }
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text, color);
-    if (!textSurface) {
-        printf("Erreur de création de la surface du texte : %s\n", TTF_GetError());
-        TTF_CloseFont(font);
-        return NULL;
-    }
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    SDL_FreeSurface(textSurface);
-    TTF_CloseFont(font);
-    return textTexture;
+static void updateGameOver(double deltaTime) {
+    (void)deltaTime;
+    // Le bot ne soumet pas de score : le classement reste celui des joueurs
+    if (botReady()) botClick(&gameOverUi, GAMEOVER_BACK);
 }
 
-void drawCircle(SDL_Renderer* renderer, int centerX, int centerY, int radius) {
-    for (int w = 0; w < radius * 2; w++) {
-        for (int h = 0; h < radius * 2; h++) {
-            int dx = radius - w;
-            int dy = radius - h;
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                SDL_RenderDrawPoint(renderer, centerX + dx, centerY + dy);
-            }
-        }
-    }
+static void renderGameOver() {
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderFillRect(renderer, NULL);
+    uiRender(&gameOverUi);
 }
 
-bool checkCollision(SDL_Rect a, Ball ball) {
-    int circleCenterX = ball.x;
-    int circleCenterY = ball.y;
-    int closestX = (a.x < circleCenterX) ? a.x + a.w : a.x;
-    int closestY = (a.y < circleCenterY) ? a.y + a.h : a.y;
-    int distanceX = circleCenterX - closestX;
-    int distanceY = circleCenterY - closestY;
-    return (distanceX * distanceX + distanceY * distanceY) <= (BALL_RADIUS * BALL_RADIUS);
-}
+static const Scene gameOverScene = {
+    .name = "fin de partie", .enter = enterGameOver, .handleEvent = handleGameOverEvent,
+    .update = updateGameOver, .render = renderGameOver
+};
 
-void initBalls() {
-    srand(time(NULL));
-    for (int i = 0; i < currentBallCount; i++) {
-        // Choisir aléatoirement un des 4 côtés (0: haut, 1: droite, 2: bas, 3: gauche)
-        int side = rand() % 4;
-        
-        switch(side) {
-            case 0: // Haut
-                balls[i].x = rand() % (SCREEN_WIDTH - BALL_RADIUS * 2) + BALL_RADIUS;
-                balls[i].y = BALL_RADIUS;
-                balls[i].dx = (rand() % 2 == 0) ? currentBallSpeed : -currentBallSpeed;
-                balls[i].dy = currentBallSpeed;
-                break;
-            case 1: // Droite
-                balls[i].x = SCREEN_WIDTH - BALL_RADIUS;
-                balls[i].y = rand() % (SCREEN_HEIGHT - BALL_RADIUS * 2) + BALL_RADIUS;
-                balls[i].dx = -currentBallSpeed;
-                balls[i].dy = (rand() % 2 == 0) ? currentBallSpeed : -currentBallSpeed;
-                break;
-            case 2: // Bas
-                balls[i].x = rand() % (SCREEN_WIDTH - BALL_RADIUS * 2) + BALL_RADIUS;
-                balls[i].y = SCREEN_HEIGHT - BALL_RADIUS;
-                balls[i].dx = (rand() % 2 == 0) ? currentBallSpeed : -currentBallSpeed;
-                balls[i].dy = -currentBallSpeed;
-                break;
-            case 3: // Gauche
-                balls[i].x = BALL_RADIUS;
-                balls[i].y = rand() % (SCREEN_HEIGHT - BALL_RADIUS * 2) + BALL_RADIUS;
-                balls[i].dx = currentBallSpeed;
-                balls[i].dy = (rand() % 2 == 0) ? currentBallSpeed : -currentBallSpeed;
-                break;
-        }
-    }
+enum { MENU_PLAY = 1, MENU_SCORES, MENU_QUIT };
+
+static const WidgetDef menuWidgets[] = {
+    UI_BUTTON(MENU_PLAY, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 120, 200, 100, "Jouer", 50, 25, 100, 50),
+    UI_BUTTON(MENU_SCORES, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, 200, 100, "Classement", 50, 25, 100, 50),
+    UI_BUTTON(MENU_QUIT, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 120, 200, 100, "Quitter", 50, 25, 100, 50)
+};
+
+static Ui menuUi;
+
+static bool enterMenu() {
+    uiLoad(&menuUi, menuWidgets, SDL_arraysize(menuWidgets));
+    return true;
 }
 
-void moveBalls() {
-    for (int i = 0; i < currentBallCount; i++) {
-        balls[i].x += balls[i].dx;
-        balls[i].y += balls[i].dy;
-        if (balls[i].x - BALL_RADIUS <= 0 || balls[i].x + BALL_RADIUS >= SCREEN_WIDTH)
-            balls[i].dx = -balls[i].dx;
-        if (balls[i].y - BALL_RADIUS <= 0 || balls[i].y + BALL_RADIUS >= SCREEN_HEIGHT)
-            balls[i].dy = -balls[i].dy;
+static void handleMenuEvent(const SDL_Event* event) {
+    switch (uiHandleEvent(&menuUi, event)) {
+        case MENU_PLAY:
+            switchScene(&characterScene);
+            break;
+        case MENU_SCORES:
+            // Afficher le classement
+            printf("Bouton 'Classement' cliqué\n");
+            switchScene(&scoresScene);
+            break;
+        case MENU_QUIT:
+            quitScenes(); // Quitter le jeu
+            break;
     }
 }
 
-void drawRoundedRect(SDL_Renderer* renderer, SDL_Rect rect, int radius, SDL_Color color) {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
-    drawCircle(renderer, rect.x + radius, rect.y + radius, radius);
-    drawCircle(renderer, rect.x + rect.w - radius, rect.y + radius, radius);
-    drawCircle(renderer, rect.x + radius, rect.y + rect.h - radius, radius);
-    drawCircle(renderer, rect.x + rect.w - radius, rect.y + rect.h - radius, radius);
-    SDL_Rect top = {rect.x + radius, rect.y, rect.w - 2 * radius, radius};
-    SDL_Rect bottom = {rect.x + radius, rect.y + rect.h - radius, rect.w - 2 * radius, radius};
-    SDL_Rect left = {rect.x, rect.y + radius, radius, rect.h - 2 * radius};
-    SDL_Rect right = {rect.x + rect.w - radius, rect.y + radius, radius, rect.h - 2 * radius};
-    SDL_RenderFillRect(renderer, &top);
-    SDL_RenderFillRect(renderer, &bottom);
-    SDL_RenderFillRect(renderer, &left);
-    SDL_RenderFillRect(renderer, &right);
-    SDL_Rect center = {rect.x + radius, rect.y + radius, rect.w - 2 * radius, rect.h - 2 * radius};
-    SDL_RenderFillRect(renderer, &center);
+static void updateMenu(double deltaTime) {
+    (void)deltaTime;
+    if (botReady()) botClick(&menuUi, isBotFinished() ? MENU_QUIT : MENU_PLAY);
 }
 
-void displayTime(Uint32 startTime) {
-    Uint32 elapsed = (SDL_GetTicks() - startTime) / 1000;
-    char timeText[20];
-    sprintf(timeText, "Temps: %u s", elapsed);
-    SDL_Color textColor = {255, 255, 255}; // Blanc
-    SDL_Texture* timeTexture = createTextTexture(timeText, textColor);
-    SDL_Rect timeRect = {10, 10, 100, 50}; // Position en haut à gauche
-    SDL_RenderCopy(renderer, timeTexture, NULL, &timeRect);
-    SDL_DestroyTexture(timeTexture);
+static void renderMenu() {
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, getTexture(menuBackgroundTexture), NULL, NULL);
+    uiRender(&menuUi);
 }
 
-void displayGameOver(Uint32 startTime) {
-    bool running = true;
-    SDL_Event event;
-    Uint32 elapsed = (SDL_GetTicks() - startTime) / 1000;
-    char timeText[50];
-    sprintf(timeText, "Perdu! Temps: %u s", elapsed);
-    SDL_Color textColor = {255, 255, 255}; // Blanc
-    SDL_Texture* gameOverText = createTextTexture(timeText, textColor);
-    SDL_Rect gameOverRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50};
-    SDL_Rect buttonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 10, 200, 100};
-    SDL_Texture* buttonText = createTextTexture("Retour au menu", textColor);
-    SDL_Color buttonColor = {0, 0, 255}; // Bouton en bleu
-    SDL_Color hoverColor = {0, 255, 0}; // Couleur de survol
-
-    // Zone de saisie du nom
-    char playerName[50] = "";
-    int nameLength = 0;
-    SDL_Rect nameInputRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 100, 200, 50};
-    SDL_Texture* nameInputText = createTextTexture("Entrez votre nom:", textColor);
-    SDL_Rect nameInputLabelRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 150, 200, 50};
-    SDL_Texture* currentNameText = NULL;
-    SDL_Rect currentNameRect = nameInputRect;
-
-    // Déterminer la difficulté actuelle
-    const char* difficulteActuelle;
-    if (currentBallCount == EASY_BALLS) {
-        difficulteActuelle = "Facile";
-    } else if (currentBallCount == MEDIUM_BALLS) {
-        difficulteActuelle = "Intermediaire";
-    } else {
-        difficulteActuelle = "Difficile";
+static const Scene menuScene = {
+    .name = "menu", .enter = enterMenu, .handleEvent = handleMenuEvent, .update = updateMenu, .render = renderMenu
+};
+
+enum {
+    SCORES_TABLE = 1, SCORES_TITLE, SCORES_BACK, SCORES_TAB, SCORES_ROW = SCORES_TAB + 3,
+    SCORES_PREVIOUS = SCORES_ROW + TOP_SCORE_COUNT, SCORES_NEXT
+};
+
+#define MAX_SCORE_PAGES 1024 // Profondeur de retour arrière dans le classement
+
+#define SCORES_TAB_BUTTON(I, X, TEXT) \
+    {.type = WIDGET_BUTTON, .id = SCORES_TAB + (I), .rect = {X, 80, 180, 40}, .text = (TEXT), .radius = 10, \
+     .color = UI_BUTTON_COLOR, .selectedColor = UI_SELECTED_COLOR, .flags = UI_NO_HOVER | UI_SELECTABLE}
+#define SCORES_ROW_LABEL(I) \
+    {.type = WIDGET_LABEL, .id = SCORES_ROW + (I), .rect = {SCREEN_WIDTH / 2 - 100, 140 + 40 * (I), 200, 50}, .flags = UI_DYNAMIC}
+
+static const WidgetDef scoresWidgets[] = {
+    {.type = WIDGET_LABEL, .id = SCORES_TABLE, .rect = {SCREEN_WIDTH / 2 - 150, 130, 300, 450}, .radius = 20,
+     .color = {0, 0, 0, 255}, .flags = UI_BACKGROUND},
+    UI_LABEL(SCORES_TITLE, SCREEN_WIDTH / 2 - 100, 20, 200, 50, "Classement"),
+    SCORES_TAB_BUTTON(0, SCREEN_WIDTH / 2 - 300, "Facile"),
+    SCORES_TAB_BUTTON(1, SCREEN_WIDTH / 2 - 90, "Intermediaire"),
+    SCORES_TAB_BUTTON(2, SCREEN_WIDTH / 2 + 120, "Difficile"),
+    SCORES_ROW_LABEL(0), SCORES_ROW_LABEL(1), SCORES_ROW_LABEL(2), SCORES_ROW_LABEL(3), SCORES_ROW_LABEL(4),
+    SCORES_ROW_LABEL(5), SCORES_ROW_LABEL(6), SCORES_ROW_LABEL(7), SCORES_ROW_LABEL(8), SCORES_ROW_LABEL(9),
+    UI_BUTTON(SCORES_PREVIOUS, SCREEN_WIDTH / 2 - 220, 330, 50, 50, "<", 17, 10, 16, 30),
+    UI_BUTTON(SCORES_NEXT, SCREEN_WIDTH / 2 + 170, 330, 50, 50, ">", 17, 10, 16, 30),
+    UI_BUTTON(SCORES_BACK, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT - 100, 200, 50, "Retour", 50, 10, 100, 30)
+};
+
+static Ui scoresUi;
+static int scoresDifficulty = 0; // 0: Facile, 1: Intermédiaire, 2: Difficile
+// Début de chaque page déjà vue : « < » relit la précédente par son curseur
+static ScoreCursor pageStarts[MAX_SCORE_PAGES];
+static int scoresPage = 0;
+
+// Recopie topScores dans les lignes du tableau, uniquement lors d'un changement d'onglet ou de page
+static void showTopScores(Ui* ui, int selectedDifficulty, int page) {
+    for (int i = 0; i < 3; i++) {
+        uiSetSelected(ui, SCORES_TAB + i, i == selectedDifficulty);
     }
-
-    // Initialiser la texture du nom
-    if (strlen(playerName) > 0) {
-        currentNameText = createTextTexture(playerName, textColor);
-    } else {
-        currentNameText = createTextTexture(" ", textColor); // Texture vide mais valide
+    for (int i = 0; i < TOP_SCORE_COUNT; i++) {
+        uiSetVisible(ui, SCORES_ROW + i, i < topScoreCount); // Un score local n'a pas encore d'id
+        uiSetText(ui, SCORES_ROW + i, "%d. %s - %d secondes", page * TOP_SCORE_COUNT + i + 1,
+                  topScores[i].nom, topScores[i].time);
     }
-
-    while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT)
-                running = false;
-            else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-                if (x > buttonRect.x && x < buttonRect.x + buttonRect.w &&
-                    y > buttonRect.y && y < buttonRect.y + buttonRect.h) {
-                    running = false;
-                }
-            }
-            else if (event.type == SDL_KEYDOWN) {
-                if (event.key.keysym.sym == SDLK_BACKSPACE && nameLength > 0) {
-                    playerName[--nameLength] = '\0';
-                }
-                else if (event.key.keysym.sym >= SDLK_a && event.key.keysym.sym <= SDLK_z && nameLength < 49) {
-                    playerName[nameLength++] = event.key.keysym.sym;
-                    playerName[nameLength] = '\0';
-                }
-                else if (event.key.keysym.sym == SDLK_RETURN && nameLength > 0) {
-                    MYSQL *con = mysql_init(NULL);
-                    if (con == NULL) {
-                        fprintf(stderr, "mysql_init() failed\n");
-                        exit(1);
-                    }
-                    if (mysql_real_connect(con, "localhost", "root", "", "game_db", 0, NULL, 0) == NULL) {
-                        finish_with_error(con);
-                    }
-                    insertScore(con, playerName, elapsed, difficulteActuelle);
-                    mysql_close(con);
-                    running = false;
-                }
-                
-                // Mettre à jour la texture du nom
-                if (currentNameText) {
-                    SDL_DestroyTexture(currentNameText);
-                }
-                if (strlen(playerName) > 0) {
-                    currentNameText = createTextTexture(playerName, textColor);
-                } else {
-                    currentNameText = createTextTexture(" ", textColor);
-                }
-            }
-        }
-
-        SDL_RenderClear(renderer);
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderFillRect(renderer, NULL);
-        
-        // Afficher le texte "Entrez votre nom"
-        SDL_RenderCopy(renderer, nameInputText, NULL, &nameInputLabelRect);
-        
-        // Afficher la zone de saisie
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderDrawRect(renderer, &nameInputRect);
-        if (currentNameText) {
-            SDL_RenderCopy(renderer, currentNameText, NULL, &currentNameRect);
-        }
-        
-        // Afficher le temps
-        SDL_RenderCopy(renderer, gameOverText, NULL, &gameOverRect);
-        
-        // Afficher le bouton retour
-        int x, y;
-        SDL_GetMouseState(&x, &y);
-        if (x > buttonRect.x && x < buttonRect.x + buttonRect.w &&
-            y > buttonRect.y && y < buttonRect.y + buttonRect.h) {
-            drawRoundedRect(renderer, buttonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, buttonRect, 20, buttonColor);
-        }
-        SDL_Rect textRect = {SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2 + 35, 100, 50};
-        SDL_RenderCopy(renderer, buttonText, NULL, &textRect);
-        
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
-    }
-
-    // Nettoyer les textures
-    if (gameOverText) SDL_DestroyTexture(gameOverText);
-    if (buttonText) SDL_DestroyTexture(buttonText);
-    if (nameInputText) SDL_DestroyTexture(nameInputText);
-    if (currentNameText) SDL_DestroyTexture(currentNameText);
+    uiSetVisible(ui, SCORES_PREVIOUS, page > 0);
+    uiSetVisible(ui, SCORES_NEXT, topScoreCount == TOP_SCORE_COUNT && page + 1 < MAX_SCORE_PAGES);
 }
 
-void displayMenu() {
-    bool running = true;
-    SDL_Event event;
-    SDL_Rect playButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 120, 200, 100};
-    SDL_Rect scoreButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, 200, 100};
-    SDL_Rect quitButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 120, 200, 100};
-    SDL_Color textColor = {255, 255, 255}; // Texte en blanc
-    SDL_Color buttonColor = {0, 0, 255}; // Bouton en bleu
-    SDL_Color hoverColor = {0, 255, 0}; // Couleur de survol
-    SDL_Texture* playButtonText = createTextTexture("Jouer", textColor);
-    SDL_Texture* scoreButtonText = createTextTexture("Classement", textColor);
-    SDL_Texture* quitButtonText = createTextTexture("Quitter", textColor);
-    menuBackgroundTexture = loadTexture("menu_background.png");
-
-    while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT)
-                running = false;
-            else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-                if (x > playButtonRect.x && x < playButtonRect.x + playButtonRect.w &&
-                    y > playButtonRect.y && y < playButtonRect.y + playButtonRect.h) {
-                    running = false;
-                    selectCharacter();
-                } else if (x > scoreButtonRect.x && x < scoreButtonRect.x + scoreButtonRect.w &&
-                           y > scoreButtonRect.y && y < scoreButtonRect.y + scoreButtonRect.h) {
-                    // Afficher le classement
-                    printf("Bouton 'Classement' cliqué\n");
-                    SDL_RenderClear(renderer);
-                    SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
-                    displayScores();
-                    SDL_RenderPresent(renderer);
-                } else if (x > quitButtonRect.x && x < quitButtonRect.x + quitButtonRect.w &&
-                           y > quitButtonRect.y && y < quitButtonRect.y + quitButtonRect.h) {
-                    running = false; // Quitter le jeu
-                }
-            }
-        }
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
-        int x, y;
-        SDL_GetMouseState(&x, &y);
-
-        // Dessiner le bouton "Jouer"
-        if (x > playButtonRect.x && x < playButtonRect.x + playButtonRect.w &&
-            y > playButtonRect.y && y < playButtonRect.y + playButtonRect.h) {
-            drawRoundedRect(renderer, playButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, playButtonRect, 20, buttonColor);
-        }
-
-        // Dessiner le bouton "Classement"
-        if (x > scoreButtonRect.x && x < scoreButtonRect.x + scoreButtonRect.w &&
-            y > scoreButtonRect.y && y < scoreButtonRect.y + scoreButtonRect.h) {
-            drawRoundedRect(renderer, scoreButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, scoreButtonRect, 20, buttonColor);
-        }
-
-        // Dessiner le bouton "Quitter"
-        if (x > quitButtonRect.x && x < quitButtonRect.x + quitButtonRect.w &&
-            y > quitButtonRect.y && y < quitButtonRect.y + quitButtonRect.h) {
-            drawRoundedRect(renderer, quitButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, quitButtonRect, 20, buttonColor);
-        }
-
-        // Afficher les textes des boutons
-        SDL_Rect playTextRect = {SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2 - 95, 100, 50};
-        SDL_RenderCopy(renderer, playButtonText, NULL, &playTextRect);
-        SDL_Rect scoreTextRect = {SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2 + 25, 100, 50};
-        SDL_RenderCopy(renderer, scoreButtonText, NULL, &scoreTextRect);
-        SDL_Rect quitTextRect = {SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2 + 145, 100, 50};
-        SDL_RenderCopy(renderer, quitButtonText, NULL, &quitTextRect);
+static bool enterScores() {
+    uiLoad(&scoresUi, scoresWidgets, SDL_arraysize(scoresWidgets));
+    scoresDifficulty = 0;
+    scoresPage = 0;
+    pageStarts[0] = SCORE_CURSOR_START;
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
-    }
-    SDL_DestroyTexture(playButtonText);
-    SDL_DestroyTexture(scoreButtonText);
-    SDL_DestroyTexture(quitButtonText);
-    SDL_DestroyTexture(menuBackgroundTexture);
+    // Charger les scores initiaux
+    topScoreCount = getTopScores(difficultyNames[scoresDifficulty], topScores, TOP_SCORE_COUNT);
+    showTopScores(&scoresUi, scoresDifficulty, scoresPage);
+    return true;
 }
 
-void displayScores() {
-    MYSQL *con = mysql_init(NULL);
-    if (con == NULL) {
-        fprintf(stderr, "mysql_init() failed\n");
-        exit(1);
-    }
-    if (mysql_real_connect(con, "localhost", "root", "", "game_db", 0, NULL, 0) == NULL) {
-        finish_with_error(con);
+static void handleScoresEvent(const SDL_Event* event) {
+    const char** difficulties = difficultyNames;
+    int clicked = uiHandleEvent(&scoresUi, event);
+    if (clicked >= SCORES_TAB && clicked < SCORES_TAB + 3) {
+        scoresDifficulty = clicked - SCORES_TAB;
+        scoresPage = 0;
+        topScoreCount = getTopScores(difficulties[scoresDifficulty], topScores, TOP_SCORE_COUNT);
+        showTopScores(&scoresUi, scoresDifficulty, scoresPage);
+    } else if (clicked == SCORES_NEXT && topScoreCount == TOP_SCORE_COUNT && scoresPage + 1 < MAX_SCORE_PAGES) {
+        // La scoresPage suivante commence après la dernière ligne affichée
+        ScoreCursor next = getScoreCursor(&topScores[TOP_SCORE_COUNT - 1]);
+        Score nextScores[TOP_SCORE_COUNT];
+        int found = getScorePage(difficulties[scoresDifficulty], next, nextScores, TOP_SCORE_COUNT);
+        if (found > 0) {
+            pageStarts[++scoresPage] = next;
+            memcpy(topScores, nextScores, sizeof(topScores));
+            topScoreCount = found;
+        }
+        showTopScores(&scoresUi, scoresDifficulty, scoresPage);
+    } else if (clicked == SCORES_PREVIOUS && scoresPage > 0) {
+        scoresPage--;
+        topScoreCount = getScorePage(difficulties[scoresDifficulty], pageStarts[scoresPage], topScores, TOP_SCORE_COUNT);
+        showTopScores(&scoresUi, scoresDifficulty, scoresPage);
+    } else if (clicked == SCORES_BACK) {
+        switchScene(&menuScene);
     }
+}
 
-    SDL_Color textColor = {255, 255, 255};
-    SDL_Color buttonColor = {0, 0, 255};
-    SDL_Color hoverColor = {0, 255, 0};
-    SDL_Color selectedColor = {255, 165, 0}; // Orange pour le niveau sélectionné
-
-    SDL_Rect titleRect = {SCREEN_WIDTH / 2 - 100, 20, 200, 50};
-    SDL_Rect difficultyButtonsRect[3] = {
-        {SCREEN_WIDTH / 2 - 300, 80, 180, 40}, // Facile
-        {SCREEN_WIDTH / 2 - 90, 80, 180, 40},  // Intermédiaire
-        {SCREEN_WIDTH / 2 + 120, 80, 180, 40}  // Difficile
-    };
-    SDL_Rect scoreRect = {SCREEN_WIDTH / 2 - 100, 140, 200, 50};
-    SDL_Rect backButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT - 100, 200, 50};
-
-    SDL_Texture* titleText = createTextTexture("Classement", textColor);
-    SDL_Texture* difficultyTexts[3];
-    difficultyTexts[0] = createTextTexture("Facile", textColor);
-    difficultyTexts[1] = createTextTexture("Intermediaire", textColor);
-    difficultyTexts[2] = createTextTexture("Difficile", textColor);
-    SDL_Texture* backButtonText = createTextTexture("Retour", textColor);
-
-    bool running = true;
-    SDL_Event event;
-    int selectedDifficulty = 0; // 0: Facile, 1: Intermédiaire, 2: Difficile
-    const char* difficulties[] = {"Facile", "Intermediaire", "Difficile"};
-
-    // Charger les scores initiaux
-    getTopScores(con, difficulties[selectedDifficulty]);
-
-    while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-            } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-                
-                // Vérifier les clics sur les boutons de difficulté
-                for (int i = 0; i < 3; i++) {
-                    if (x > difficultyButtonsRect[i].x && x < difficultyButtonsRect[i].x + difficultyButtonsRect[i].w &&
-                        y > difficultyButtonsRect[i].y && y < difficultyButtonsRect[i].y + difficultyButtonsRect[i].h) {
-                        selectedDifficulty = i;
-                        getTopScores(con, difficulties[selectedDifficulty]);
-                        break;
-                    }
-                }
-
-                // Vérifier le clic sur le bouton Retour
-                if (x > backButtonRect.x && x < backButtonRect.x + backButtonRect.w &&
-                    y > backButtonRect.y && y < backButtonRect.y + backButtonRect.h) {
-                    running = false;
-                }
-            }
-        }
-
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
+static void renderScores() {
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, getTexture(menuBackgroundTexture), NULL, NULL);
+    uiRender(&scoresUi);
+}
 
-        // Dessiner le tableau de classement
-        SDL_Rect tableRect = {SCREEN_WIDTH / 2 - 150, 130, 300, 450};
-        SDL_Color tableColor = {0, 0, 0, 128};
-        drawRoundedRect(renderer, tableRect, 20, tableColor);
+static const Scene scoresScene = {
+    .name = "classement", .enter = enterScores, .handleEvent = handleScoresEvent, .render = renderScores
+};
 
-        // Afficher le titre
-        SDL_RenderCopy(renderer, titleText, NULL, &titleRect);
+enum { PAUSE_TITLE = 1, PAUSE_RESUME, PAUSE_QUIT };
 
-        // Afficher les boutons de difficulté
-        for (int i = 0; i < 3; i++) {
-            if (i == selectedDifficulty) {
-                drawRoundedRect(renderer, difficultyButtonsRect[i], 10, selectedColor);
-            } else {
-                drawRoundedRect(renderer, difficultyButtonsRect[i], 10, buttonColor);
-            }
-            SDL_RenderCopy(renderer, difficultyTexts[i], NULL, &difficultyButtonsRect[i]);
-        }
+static const WidgetDef pauseWidgets[] = {
+    UI_LABEL(PAUSE_TITLE, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 100, 200, 50, "PAUSE"),
+    UI_BUTTON(PAUSE_RESUME, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, 200, 50, "Reprendre", 50, 10, 100, 30),
+    UI_BUTTON(PAUSE_QUIT, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 60, 200, 50, "Quitter", 50, 10, 100, 30)
+};
 
-        // Réinitialiser la position des scores
-        scoreRect.y = 140;
-
-        // Afficher les scores
-        for (int i = 0; i < 10; i++) {
-            if (topScores[i].id != 0) {
-                char scoreText[50];
-                sprintf(scoreText, "%d. %s - %d secondes", i + 1, topScores[i].nom, topScores[i].time);
-                SDL_Texture* scoreTexture = createTextTexture(scoreText, textColor);
-                SDL_RenderCopy(renderer, scoreTexture, NULL, &scoreRect);
-                scoreRect.y += 40;
-                SDL_DestroyTexture(scoreTexture);
-            }
-        }
+static Ui pauseUi;
 
-        // Dessiner le bouton "Retour"
-        int x, y;
-        SDL_GetMouseState(&x, &y);
-        if (x > backButtonRect.x && x < backButtonRect.x + backButtonRect.w &&
-            y > backButtonRect.y && y < backButtonRect.y + backButtonRect.h) {
-            drawRoundedRect(renderer, backButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, backButtonRect, 20, buttonColor);
-        }
-        SDL_Rect backTextRect = {SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT - 90, 100, 30};
-        SDL_RenderCopy(renderer, backButtonText, NULL, &backTextRect);
+// Posée sur la partie : tant qu'elle est au sommet, la simulation n'avance pas
+static bool enterPause() {
+    uiLoad(&pauseUi, pauseWidgets, SDL_arraysize(pauseWidgets));
+    return true;
+}
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+static void handlePauseEvent(const SDL_Event* event) {
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_ESCAPE) {
+        popScene();
+        return;
     }
-
-    // Nettoyer les ressources
-    SDL_DestroyTexture(titleText);
-    SDL_DestroyTexture(backButtonText);
-    for (int i = 0; i < 3; i++) {
-        SDL_DestroyTexture(difficultyTexts[i]);
+    switch (uiHandleEvent(&pauseUi, event)) {
+        case PAUSE_RESUME:
+            Mix_PlayChannel(-1, buttonSound, 0);
+            popScene();
+            break;
+        case PAUSE_QUIT:
+            Mix_PlayChannel(-1, buttonSound, 0);
+            quitScenes(); // La partie sort aussi : son enregistrement est écrit
+            break;
     }
-    mysql_close(con);
 }
 
-void insertScore(MYSQL *con, const char* nom, int time, const char* difficulte) {
-    char query[200];
-    sprintf(query, "INSERT INTO Scores (Nom, Time, Difficulte) VALUES ('%s', %d, '%s')", nom, time, difficulte);
-    if (mysql_query(con, query)) {
-        finish_with_error(con);
-    }
-    printf("Score inséré : %s - %d s - %s\n", nom, time, difficulte);
+static void renderPause() {
+    // Rendre l'écran semi-transparent
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
+    SDL_RenderClear(renderer);
+    uiRender(&pauseUi);
 }
 
-void displayPauseMenu() {
-    bool running = true;
-    SDL_Event event;
-    SDL_Color textColor = {255, 255, 255};
-    SDL_Color buttonColor = {0, 0, 255};
-    SDL_Color hoverColor = {0, 255, 0};
-
-    // Rectangle pour le titre
-    SDL_Rect titleRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 100, 200, 50};
-    SDL_Texture* titleText = createTextTexture("PAUSE", textColor);
-
-    // Rectangles pour les boutons
-    SDL_Rect resumeButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, 200, 50};
-    SDL_Rect quitButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 60, 200, 50};
-
-    // Textures pour les textes des boutons
-    SDL_Texture* resumeText = createTextTexture("Reprendre", textColor);
-    SDL_Texture* quitText = createTextTexture("Quitter", textColor);
-
-    while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-                exit(0);
-            } else if (event.type == SDL_KEYDOWN) {
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    running = false;
-                    return;
-                }
-            } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-
-                if (x > resumeButtonRect.x && x < resumeButtonRect.x + resumeButtonRect.w &&
-                    y > resumeButtonRect.y && y < resumeButtonRect.y + resumeButtonRect.h) {
-                    Mix_PlayChannel(-1, buttonSound, 0);
-                    running = false;
-                    return;
-                }
-                else if (x > quitButtonRect.x && x < quitButtonRect.x + quitButtonRect.w &&
-                         y > quitButtonRect.y && y < quitButtonRect.y + quitButtonRect.h) {
-                    Mix_PlayChannel(-1, buttonSound, 0);
-                    running = false;
-                    exit(0);
-                }
-            }
-        }
-
-        // Rendre l'écran semi-transparent
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
-        SDL_RenderClear(renderer);
-
-        // Afficher le titre
-        SDL_RenderCopy(renderer, titleText, NULL, &titleRect);
+static const Scene pauseScene = {
+    .name = "pause", .enter = enterPause, .handleEvent = handlePauseEvent, .render = renderPause
+};
 
-        // Afficher les boutons
-        int x, y;
-        SDL_GetMouseState(&x, &y);
+// Interpolation entre l'état du pas précédent et celui du pas courant
+static int lerpPosition(float previous, float current, float alpha) {
+    return (int)lroundf(previous + (current - previous) * alpha);
+}
 
-        // Bouton Reprendre
-        if (x > resumeButtonRect.x && x < resumeButtonRect.x + resumeButtonRect.w &&
-            y > resumeButtonRect.y && y < resumeButtonRect.y + resumeButtonRect.h) {
-            drawRoundedRect(renderer, resumeButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, resumeButtonRect, 20, buttonColor);
-        }
-        SDL_Rect resumeTextRect = {resumeButtonRect.x + 50, resumeButtonRect.y + 10, 100, 30};
-        SDL_RenderCopy(renderer, resumeText, NULL, &resumeTextRect);
+// Copie plein écran du fond de jeu, mesurée à part : c'est la plus grosse texture
+static void renderBackground(SDL_Texture* background) {
+    PROFILE_SCOPE("fond");
+    SDL_RenderCopy(renderer, background, NULL, NULL);
+}
 
-        // Bouton Quitter
-        if (x > quitButtonRect.x && x < quitButtonRect.x + quitButtonRect.w &&
-            y > quitButtonRect.y && y < quitButtonRect.y + quitButtonRect.h) {
-            drawRoundedRect(renderer, quitButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, quitButtonRect, 20, buttonColor);
-        }
-        SDL_Rect quitTextRect = {quitButtonRect.x + 50, quitButtonRect.y + 10, 100, 30};
-        SDL_RenderCopy(renderer, quitText, NULL, &quitTextRect);
+// Décor, joueur et balles de la partie en cours ; commun au jeu et aux replays
+static void renderSimulation(Resource** resources, float alpha) {
+    PROFILE_SCOPE("renderSimulation");
+    SDL_RenderClear(renderer);
+    renderBackground(getTexture(resources[GAME_BACKGROUND]));
+    SDL_Rect playerRect = {
+        lerpPosition(simulation.prevPlayerX, simulation.player.x, alpha),
+        lerpPosition(simulation.prevPlayerY, simulation.player.y, alpha),
+        simulation.player.w,
+        simulation.player.h
+    };
+    SDL_RenderCopy(renderer, getTexture(playerTexture), NULL, &playerRect);
+
+    // Dessiner les balles : un seul appel de rendu quel que soit leur nombre
+    const BallArrays* balls = &simulation.balls;
+    for (int i = 0; i < simulation.ballCount; i++) {
+        SDL_FRect ballRect = {
+            lerpPosition(balls->prevX[i], balls->x[i], alpha) - BALL_RADIUS,
+            lerpPosition(balls->prevY[i], balls->y[i], alpha) - BALL_RADIUS,
+            BALL_RADIUS * 2,
+            BALL_RADIUS * 2
+        };
+        drawSprite(getTexture(resources[GAME_BALL]), NULL, ballRect, 0.0f, SPRITE_WHITE);
+    }
+    flushSprites();
+}
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+// Écrit l'enregistrement de la partie qui se termine, puis le libère
+static void saveReplay(Replay* replay, bool recording) {
+    if (recording) {
+        replayFinish(replay, &simulation);
+        long size = replaySave(replay, REPLAY_LAST_PATH);
+        if (size >= 0) printf("Partie enregistree : %s (%ld octets)\n", REPLAY_LAST_PATH, size);
     }
-
-    // Nettoyer les ressources
-    SDL_DestroyTexture(titleText);
-    SDL_DestroyTexture(resumeText);
-    SDL_DestroyTexture(quitText);
+    replayFree(replay);
 }
 
-void startGame() {
-    player.w = 50;
-    player.h = 50;
-    player.x = SCREEN_WIDTH / 2 - player.w / 2;
-    player.y = SCREEN_HEIGHT / 2 - player.h / 2;
-    initBalls();
-    startTime = SDL_GetTicks();
-    bool running = true;
-    SDL_Event event;
+static Replay gameReplay;
+static bool gameRecording = false;
+static double accumulator = 0.0;
+static Resource* gameSet[SDL_arraysize(gameResources)];
+
+static bool enterGame() {
+    // Graine différente à chaque partie ; la simulation elle-même est déterministe
+    Uint64 seed = (Uint64)time(NULL) ^ SDL_GetPerformanceCounter();
+    bool initialized;
+    if (stressBallCount > 0) {
+        // Mode stress : nombre de balles imposé, vitesse de la difficulté choisie
+        int ballCount, ballSpeed;
+        getDifficultyParams(currentDifficulty, &ballCount, &ballSpeed);
+        initialized = simInit(&simulation, stressBallCount, ballSpeed, seed);
+        simulation.difficulty = currentDifficulty;
+    } else {
+        initialized = simInitDifficulty(&simulation, currentDifficulty, seed);
+    }
+    if (!initialized) return false;
+    if (ballCollisionMode && !enableBallCollisions(&simulation)) {
+        simFree(&simulation);
+        return false;
+    }
+    // Graine et entrées suffisent à rejouer la partie (voir --replay)
+    replayInit(&gameReplay, &simulation, seed);
+    gameRecording = true;
+    accumulator = 0.0;
+    acquireResourceSet(gameResources, SDL_arraysize(gameResources), gameSet);
 
     // Jouer la musique de fond
     Mix_PlayMusic(backgroundMusic, -1); // -1 pour jouer en boucle
-    
-    while (running) {
-        // Gestion des événements
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-            } else if (event.type == SDL_KEYDOWN) {
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    displayPauseMenu();
-                }
-            }
-        }
-
-        // Gestion des mouvements du joueur
-        const Uint8* keys = SDL_GetKeyboardState(NULL);
-        if (keys[SDL_SCANCODE_UP] && player.y > 0) player.y -= PLAYER_SPEED;
-        if (keys[SDL_SCANCODE_DOWN] && player.y + player.h < SCREEN_HEIGHT) player.y += PLAYER_SPEED;
-        if (keys[SDL_SCANCODE_LEFT] && player.x > 0) player.x -= PLAYER_SPEED;
-        if (keys[SDL_SCANCODE_RIGHT] && player.x + player.w < SCREEN_WIDTH) player.x += PLAYER_SPEED;
+    return true;
+}
 
-        // Mouvement des balles
-        if (balls != NULL) {
-            moveBalls();
-        }
+// Collision ou sortie par la pause : même nettoyage, l'enregistrement est toujours écrit
+static void exitGame() {
+    saveReplay(&gameReplay, gameRecording);
+    simFree(&simulation);
+    releaseResourceSet(gameSet, SDL_arraysize(gameResources));
+}
 
-        // Vérification des collisions
-        bool collision = false;
-        if (balls != NULL) {
-            for (int i = 0; i < currentBallCount; i++) {
-                if (checkCollision(player, balls[i])) {
-                    collision = true;
-                    break;
-                }
-            }
-        }
+static void handleGameEvent(const SDL_Event* event) {
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_ESCAPE) {
+        pushScene(&pauseScene);
+    }
+}
 
-        if (collision) {
-            Mix_PlayChannel(-1, collisionSound, 0); // Jouer le son de collision
-            displayGameOver(startTime);
-            if (balls != NULL) {
-                free(balls);
-                balls = NULL;
-            }
-            displayMenu();
-            return;
-        }
+static void updateGame(double deltaTime) {
+    accumulator += deltaTime;
 
-        // Rendu
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, backgroundTexture, NULL, NULL);
-        SDL_RenderCopy(renderer, playerTexture, NULL, &player);
-
-        // Dessiner les balles
-        if (balls != NULL) {
-            for (int i = 0; i < currentBallCount; i++) {
-                SDL_Rect ballRect = {
-                    balls[i].x - BALL_RADIUS,
-                    balls[i].y - BALL_RADIUS,
-                    BALL_RADIUS * 2,
-                    BALL_RADIUS * 2
-                };
-                SDL_RenderCopy(renderer, ballTexture, NULL, &ballRect);
-            }
-        }
+    // Gestion des mouvements du joueur : clavier, ou bot avec --bot
+    SimInput input = readPlayerInput(&simulation);
 
-        displayTime(startTime);
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+    // Simulation à pas fixe : autant de pas que le temps réel écoulé en exige
+    bool collision = false;
+    while (accumulator >= TICK_SECONDS && !collision) {
+        PROFILE_SCOPE("simStep");
+        accumulator -= TICK_SECONDS;
+        gameRecording = gameRecording && replayRecord(&gameReplay, input);
+        collision = simStep(&simulation, input);
     }
 
-    // Nettoyage
-    if (balls != NULL) {
-        free(balls);
-        balls = NULL;
+    if (collision) {
+        Mix_PlayChannel(-1, collisionSound, 0); // Jouer le son de collision
+        // Le temps de survie est compté en pas de simulation, identique sur toutes les machines
+        gameOverElapsed = simulation.tick / TICK_RATE;
+        botGameOver(gameOverElapsed);
+        switchScene(&gameOverScene);
     }
-
-    // Arrêter la musique
-    Mix_HaltMusic();
 }
 
-void displayTutorial() {
-    bool running = true;
-    SDL_Event event;
-    SDL_Color textColor = {255, 255, 255};
-    SDL_Color buttonColor = {0, 0, 255};
-    SDL_Color hoverColor = {0, 255, 0};
-
-    // Rectangle pour le titre
-    SDL_Rect titleRect = {SCREEN_WIDTH / 2 - 200, 20, 400, 50};
-    SDL_Texture* titleText = createTextTexture("Tutoriel", textColor);
-
-    // Textures pour les instructions
-    SDL_Texture* instruction1 = createTextTexture("Utilisez les fleches directionnelles pour vous deplacer", textColor);
-    SDL_Texture* instruction2 = createTextTexture("Evitez les balles qui rebondissent", textColor);
-    SDL_Texture* instruction3 = createTextTexture("Appuyez sur ECHAP pour mettre le jeu en pause", textColor);
-    SDL_Texture* instruction4 = createTextTexture("Survivez le plus longtemps possible !", textColor);
-
-    // Rectangles pour les instructions
-    SDL_Rect instruction1Rect = {SCREEN_WIDTH / 2 - 300, 100, 600, 40};
-    SDL_Rect instruction2Rect = {SCREEN_WIDTH / 2 - 300, 160, 600, 40};
-    SDL_Rect instruction3Rect = {SCREEN_WIDTH / 2 - 300, 220, 600, 40};
-    SDL_Rect instruction4Rect = {SCREEN_WIDTH / 2 - 300, 280, 600, 40};
-
-    // Rectangle pour le bouton Commencer
-    SDL_Rect startButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT - 100, 200, 50};
-    SDL_Texture* startText = createTextTexture("Commencer", textColor);
-
-    // Animation des flèches
-    SDL_Texture* arrowKeys = loadTexture("assets/arrow_keys.png");
-    SDL_Rect arrowRect = {SCREEN_WIDTH / 2 - 100, 350, 200, 200};
-    float arrowScale = 1.0f;
-    bool increasing = true;
+static void renderGame() {
+    // Rendu, interpolé entre les deux derniers pas
+    renderSimulation(gameSet, (float)SDL_min(accumulator / TICK_SECONDS, 1.0));
+    displayTime(simulation.tick / TICK_RATE);
+}
 
-    Uint32 lastTime = SDL_GetTicks();
-    const float ANIMATION_SPEED = 0.5f;
+static const Scene gameScene = {
+    .name = "partie", .enter = enterGame, .exit = exitGame, .handleEvent = handleGameEvent,
+    .update = updateGame, .render = renderGame
+};
+
+// Relecture d'un enregistrement : flèches gauche/droite pour reculer ou avancer,
+// espace pour la pause, Échap pour quitter. En vitesse maximale, chaque image
+// enchaîne autant de pas que le budget d'une image le permet.
+static const char* replayPath = NULL; // --replay fichier : relit une partie au lieu du menu
+static bool replayMaxSpeed = false;   // --replay-speed max : sans attendre le temps réel
+static Replay replay;
+static ReplayPlayer replayPlayer;
+static Resource* replaySet[SDL_arraysize(gameResources)];
+static Uint64 stepBudget = 0;
+static bool replayPaused = false;
+static bool replayFinished = false;
+static double replayAccumulator = 0.0;
+
+static bool enterReplay() {
+    if (!replayLoad(&replay, replayPath)) return false;
+    if (!replayStartSimulation(&replay, &simulation)) {
+        replayFree(&replay);
+        return false;
+    }
+    if (!replayPlayerInit(&replayPlayer, &replay, &simulation)) {
+        simFree(&simulation);
+        replayFree(&replay);
+        return false;
+    }
+    printf("Replay %s : %s, %d balles, %u pas\n", replayPath, difficultyNames[replay.difficulty], replay.ballCount, replay.tickCount);
+    acquireResourceSet(gameResources, SDL_arraysize(gameResources), replaySet);
+    stepBudget = (Uint64)(SDL_GetPerformanceFrequency() * REPLAY_STEP_BUDGET);
+    replayAccumulator = 0.0;
+    replayPaused = false;
+    replayFinished = false;
+    return true;
+}
 
-    while (running) {
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
+static void exitReplay() {
+    releaseResourceSet(replaySet, SDL_arraysize(gameResources));
+    replayPlayerFree(&replayPlayer);
+    simFree(&simulation);
+    replayFree(&replay);
+}
 
-        // Animation des flèches
-        if (increasing) {
-            arrowScale += ANIMATION_SPEED * deltaTime;
-            if (arrowScale >= 1.2f) increasing = false;
+static void handleReplayEvent(const SDL_Event* event) {
+    if (event->type != SDL_KEYDOWN) return;
+    SDL_Keycode key = event->key.keysym.sym;
+    if (key == SDLK_ESCAPE) {
+        popScene();
+    } else if (key == SDLK_SPACE) {
+        replayPaused = !replayPaused;
+    } else if (key == SDLK_LEFT || key == SDLK_RIGHT) {
+        Uint32 tick = simulation.tick;
+        if (key == SDLK_RIGHT) {
+            tick += REPLAY_SEEK_TICKS;
         } else {
-            arrowScale -= ANIMATION_SPEED * deltaTime;
-            if (arrowScale <= 1.0f) increasing = true;
+            tick = tick > REPLAY_SEEK_TICKS ? tick - REPLAY_SEEK_TICKS : 0;
         }
+        replayPlayerSeek(&replayPlayer, tick);
+        replayFinished = false;
+        replayAccumulator = 0.0;
+    }
+}
 
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-                exit(0);
-            } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-
-                if (x >= startButtonRect.x && x < startButtonRect.x + startButtonRect.w &&
-                    y >= startButtonRect.y && y < startButtonRect.y + startButtonRect.h) {
-                    Mix_PlayChannel(-1, buttonSound, 0);
-                    running = false;
-                }
-            }
+static void updateReplay(double deltaTime) {
+    replayAccumulator += deltaTime;
+    if (replayPaused || replayFinished) {
+        replayAccumulator = 0.0;
+        return;
+    }
+    if (replayMaxSpeed) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        while (!replayFinished && SDL_GetPerformanceCounter() - start < stepBudget) {
+            replayFinished = !replayPlayerStep(&replayPlayer);
         }
-
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
-
-        // Afficher le titre
-        SDL_RenderCopy(renderer, titleText, NULL, &titleRect);
-
-        // Afficher les instructions
-        SDL_RenderCopy(renderer, instruction1, NULL, &instruction1Rect);
-        SDL_RenderCopy(renderer, instruction2, NULL, &instruction2Rect);
-        SDL_RenderCopy(renderer, instruction3, NULL, &instruction3Rect);
-        SDL_RenderCopy(renderer, instruction4, NULL, &instruction4Rect);
-
-        // Afficher l'animation des flèches
-        if (arrowKeys) {
-            SDL_Rect scaledArrowRect = {
-                arrowRect.x - (arrowRect.w * (arrowScale - 1.0f)) / 2,
-                arrowRect.y - (arrowRect.h * (arrowScale - 1.0f)) / 2,
-                arrowRect.w * arrowScale,
-                arrowRect.h * arrowScale
-            };
-            SDL_RenderCopy(renderer, arrowKeys, NULL, &scaledArrowRect);
+        replayAccumulator = 0.0;
+    } else {
+        while (replayAccumulator >= TICK_SECONDS && !replayFinished) {
+            replayAccumulator -= TICK_SECONDS;
+            replayFinished = !replayPlayerStep(&replayPlayer);
         }
+    }
+    // Reste affiché à la fin : on peut encore reculer
+    if (replayFinished) {
+        printf("Replay termine : %u s (%u pas)%s\n", simulation.tick / TICK_RATE, simulation.tick,
+               simulation.over ? "" : ", partie interrompue");
+    }
+}
 
-        // Afficher le bouton Commencer
-        int x, y;
-        SDL_GetMouseState(&x, &y);
-        if (x >= startButtonRect.x && x < startButtonRect.x + startButtonRect.w &&
-            y >= startButtonRect.y && y < startButtonRect.y + startButtonRect.h) {
-            drawRoundedRect(renderer, startButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, startButtonRect, 20, buttonColor);
-        }
-        SDL_Rect startTextRect = {startButtonRect.x + 50, startButtonRect.y + 10, 100, 30};
-        SDL_RenderCopy(renderer, startText, NULL, &startTextRect);
+static void renderReplay() {
+    renderSimulation(replaySet, (float)(replayAccumulator / TICK_SECONDS));
+    displayTime(simulation.tick / TICK_RATE);
+}
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
-    }
+static const Scene replayScene = {
+    .name = "replay", .enter = enterReplay, .exit = exitReplay, .handleEvent = handleReplayEvent,
+    .update = updateReplay, .render = renderReplay
+};
+
+enum { TUTORIAL_TITLE = 1, TUTORIAL_LINE, TUTORIAL_START = TUTORIAL_LINE + 4 };
+
+static const WidgetDef tutorialWidgets[] = {
+    UI_LABEL(TUTORIAL_TITLE, SCREEN_WIDTH / 2 - 200, 20, 400, 50, "Tutoriel"),
+    UI_LABEL(TUTORIAL_LINE, SCREEN_WIDTH / 2 - 300, 100, 600, 40, "Utilisez les fleches directionnelles pour vous deplacer"),
+    UI_LABEL(TUTORIAL_LINE + 1, SCREEN_WIDTH / 2 - 300, 160, 600, 40, "Evitez les balles qui rebondissent"),
+    UI_LABEL(TUTORIAL_LINE + 2, SCREEN_WIDTH / 2 - 300, 220, 600, 40, "Appuyez sur ECHAP pour mettre le jeu en pause"),
+    UI_LABEL(TUTORIAL_LINE + 3, SCREEN_WIDTH / 2 - 300, 280, 600, 40, "Survivez le plus longtemps possible !"),
+    UI_BUTTON(TUTORIAL_START, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT - 100, 200, 50, "Commencer", 50, 10, 100, 30)
+};
+
+static Ui tutorialUi;
+static Resource* tutorialSet[SDL_arraysize(tutorialResources)];
+// Animation des flèches
+static float arrowScale = 1.0f;
+static bool arrowGrowing = true;
+
+static bool enterTutorial() {
+    uiLoad(&tutorialUi, tutorialWidgets, SDL_arraysize(tutorialWidgets));
+    acquireResourceSet(tutorialResources, SDL_arraysize(tutorialResources), tutorialSet);
+    arrowScale = 1.0f;
+    arrowGrowing = true;
+    return true;
+}
 
+static void exitTutorial() {
     // Nettoyer les ressources
-    SDL_DestroyTexture(titleText);
-    SDL_DestroyTexture(instruction1);
-    SDL_DestroyTexture(instruction2);
-    SDL_DestroyTexture(instruction3);
-    SDL_DestroyTexture(instruction4);
-    SDL_DestroyTexture(startText);
-    if (arrowKeys) SDL_DestroyTexture(arrowKeys);
+    releaseResourceSet(tutorialSet, SDL_arraysize(tutorialResources));
 }
 
-void selectDifficulty() {
-    bool running = true;
-    SDL_Event event;
-    SDL_Color textColor = {255, 255, 255};
-    SDL_Color buttonColor = {0, 0, 255};
-    SDL_Color hoverColor = {0, 255, 0};
-
-    // Rectangle pour le titre
-    SDL_Rect titleRect = {SCREEN_WIDTH / 2 - 150, 50, 300, 50};
-
-    // Rectangles pour les boutons
-    SDL_Rect easyButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 120, 200, 80};
-    SDL_Rect mediumButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, 200, 80};
-    SDL_Rect hardButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 120, 200, 80};
-
-    // Textures pour les textes
-    SDL_Texture* titleText = createTextTexture("Selectionnez la difficulte", textColor);
-    SDL_Texture* easyText = createTextTexture("Facile", textColor);
-    SDL_Texture* mediumText = createTextTexture("Intermediaire", textColor);
-    SDL_Texture* hardText = createTextTexture("Difficile", textColor);
-
-    while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-            } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-                
-                if (x > easyButtonRect.x && x < easyButtonRect.x + easyButtonRect.w &&
-                    y > easyButtonRect.y && y < easyButtonRect.y + easyButtonRect.h) {
-                    currentBallCount = EASY_BALLS;
-                    currentBallSpeed = EASY_SPEED;
-                    Mix_PlayChannel(-1, buttonSound, 0);
-                    displayTutorial();
-                    if (balls) free(balls);
-                    balls = (Ball*)malloc(currentBallCount * sizeof(Ball));
-                    if (!balls) {
-                        printf("Erreur d'allocation memoire pour les balles\n");
-                        exit(1);
-                    }
-                    SDL_DestroyTexture(titleText);
-                    SDL_DestroyTexture(easyText);
-                    SDL_DestroyTexture(mediumText);
-                    SDL_DestroyTexture(hardText);
-                    startGame();
-                    return;
-                }
-                else if (x > mediumButtonRect.x && x < mediumButtonRect.x + mediumButtonRect.w &&
-                         y > mediumButtonRect.y && y < mediumButtonRect.y + mediumButtonRect.h) {
-                    currentBallCount = MEDIUM_BALLS;
-                    currentBallSpeed = MEDIUM_SPEED;
-                    Mix_PlayChannel(-1, buttonSound, 0);
-                    displayTutorial();
-                    if (balls) free(balls);
-                    balls = (Ball*)malloc(currentBallCount * sizeof(Ball));
-                    if (!balls) {
-                        printf("Erreur d'allocation memoire pour les balles\n");
-                        exit(1);
-                    }
-                    SDL_DestroyTexture(titleText);
-                    SDL_DestroyTexture(easyText);
-                    SDL_DestroyTexture(mediumText);
-                    SDL_DestroyTexture(hardText);
-                    startGame();
-                    return;
-                }
-                else if (x > hardButtonRect.x && x < hardButtonRect.x + hardButtonRect.w &&
-                         y > hardButtonRect.y && y < hardButtonRect.y + hardButtonRect.h) {
-                    currentBallCount = HARD_BALLS;
-                    currentBallSpeed = HARD_SPEED;
-                    Mix_PlayChannel(-1, buttonSound, 0);
-                    displayTutorial();
-                    if (balls) free(balls);
-                    balls = (Ball*)malloc(currentBallCount * sizeof(Ball));
-                    if (!balls) {
-                        printf("Erreur d'allocation memoire pour les balles\n");
-                        exit(1);
-                    }
-                    SDL_DestroyTexture(titleText);
-                    SDL_DestroyTexture(easyText);
-                    SDL_DestroyTexture(mediumText);
-                    SDL_DestroyTexture(hardText);
-                    startGame();
-                    return;
-                }
-            }
-        }
+static void handleTutorialEvent(const SDL_Event* event) {
+    if (uiHandleEvent(&tutorialUi, event) == TUTORIAL_START) {
+        Mix_PlayChannel(-1, buttonSound, 0);
+        switchScene(&gameScene);
+    }
+}
 
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
+static void updateTutorial(double deltaTime) {
+    const float ANIMATION_SPEED = 0.5f;
 
-        // Afficher le titre
-        SDL_RenderCopy(renderer, titleText, NULL, &titleRect);
+    // Animation des flèches
+    if (arrowGrowing) {
+        arrowScale += ANIMATION_SPEED * deltaTime;
+        if (arrowScale >= 1.2f) arrowGrowing = false;
+    } else {
+        arrowScale -= ANIMATION_SPEED * deltaTime;
+        if (arrowScale <= 1.0f) arrowGrowing = true;
+    }
+    if (botReady()) botClick(&tutorialUi, TUTORIAL_START);
+}
 
-        // Obtenir la position de la souris
-        int x, y;
-        SDL_GetMouseState(&x, &y);
+static void renderTutorial() {
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, getTexture(menuBackgroundTexture), NULL, NULL);
 
-        // Dessiner les boutons avec effet de survol
-        // Bouton Facile
-        if (x > easyButtonRect.x && x < easyButtonRect.x + easyButtonRect.w &&
-            y > easyButtonRect.y && y < easyButtonRect.y + easyButtonRect.h) {
-            drawRoundedRect(renderer, easyButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, easyButtonRect, 20, buttonColor);
-        }
+    // Afficher l'animation des flèches
+    Resource* arrowKeys = tutorialSet[0];
+    if (arrowKeys) {
+        SDL_Rect arrowRect = {SCREEN_WIDTH / 2 - 100, 350, 200, 200};
+        SDL_Rect scaledArrowRect = {
+            arrowRect.x - (arrowRect.w * (arrowScale - 1.0f)) / 2,
+            arrowRect.y - (arrowRect.h * (arrowScale - 1.0f)) / 2,
+            arrowRect.w * arrowScale,
+            arrowRect.h * arrowScale
+        };
+        SDL_RenderCopy(renderer, getTexture(arrowKeys), NULL, &scaledArrowRect);
+    }
 
-        // Bouton Intermédiaire
-        if (x > mediumButtonRect.x && x < mediumButtonRect.x + mediumButtonRect.w &&
-            y > mediumButtonRect.y && y < mediumButtonRect.y + mediumButtonRect.h) {
-            drawRoundedRect(renderer, mediumButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, mediumButtonRect, 20, buttonColor);
-        }
+    uiRender(&tutorialUi);
+}
 
-        // Bouton Difficile
-        if (x > hardButtonRect.x && x < hardButtonRect.x + hardButtonRect.w &&
-            y > hardButtonRect.y && y < hardButtonRect.y + hardButtonRect.h) {
-            drawRoundedRect(renderer, hardButtonRect, 20, hoverColor);
-        } else {
-            drawRoundedRect(renderer, hardButtonRect, 20, buttonColor);
-        }
+static const Scene tutorialScene = {
+    .name = "tutoriel", .enter = enterTutorial, .exit = exitTutorial, .handleEvent = handleTutorialEvent,
+    .update = updateTutorial, .render = renderTutorial
+};
+
+// Les boutons suivent l'ordre de l'énumération Difficulty
+enum { SELECT_TITLE = 1, SELECT_EASY, SELECT_MEDIUM, SELECT_HARD };
+
+static const WidgetDef difficultyWidgets[] = {
+    UI_LABEL(SELECT_TITLE, SCREEN_WIDTH / 2 - 150, 50, 300, 50, "Selectionnez la difficulte"),
+    UI_BUTTON(SELECT_EASY, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 120, 200, 80, "Facile", 50, 25, 100, 30),
+    UI_BUTTON(SELECT_MEDIUM, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, 200, 80, "Intermediaire", 50, 25, 100, 30),
+    UI_BUTTON(SELECT_HARD, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 120, 200, 80, "Difficile", 50, 25, 100, 30)
+};
+
+static Ui difficultyUi;
+// Préchargement du tutoriel et de la partie pendant que le joueur choisit
+static Resource* preloadTutorialSet[SDL_arraysize(tutorialResources)];
+static Resource* preloadGameSet[SDL_arraysize(gameResources)];
+
+static bool enterDifficulty() {
+    uiLoad(&difficultyUi, difficultyWidgets, SDL_arraysize(difficultyWidgets));
+    acquireResourceSet(tutorialResources, SDL_arraysize(tutorialResources), preloadTutorialSet);
+    acquireResourceSet(gameResources, SDL_arraysize(gameResources), preloadGameSet);
+    return true;
+}
 
-        // Afficher les textes des boutons
-        SDL_Rect textRect = {easyButtonRect.x + 50, easyButtonRect.y + 25, 100, 30};
-        SDL_RenderCopy(renderer, easyText, NULL, &textRect);
-        
-        textRect.y = mediumButtonRect.y + 25;
-        SDL_RenderCopy(renderer, mediumText, NULL, &textRect);
-        
-        textRect.y = hardButtonRect.y + 25;
-        SDL_RenderCopy(renderer, hardText, NULL, &textRect);
-
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+// Le tutoriel est déjà entré : les ressources libérées restent en cache, la partie les retrouve
+static void exitDifficulty() {
+    releaseResourceSet(preloadTutorialSet, SDL_arraysize(tutorialResources));
+    releaseResourceSet(preloadGameSet, SDL_arraysize(gameResources));
+}
+
+static void handleDifficultyEvent(const SDL_Event* event) {
+    int clicked = uiHandleEvent(&difficultyUi, event);
+    if (clicked >= SELECT_EASY && clicked <= SELECT_HARD) {
+        currentDifficulty = (Difficulty)(clicked - SELECT_EASY);
+        Mix_PlayChannel(-1, buttonSound, 0);
+        switchScene(&tutorialScene);
     }
+}
 
-    // Nettoyer les textures
-    SDL_DestroyTexture(titleText);
-    SDL_DestroyTexture(easyText);
-    SDL_DestroyTexture(mediumText);
-    SDL_DestroyTexture(hardText);
+static void updateDifficulty(double deltaTime) {
+    (void)deltaTime;
+    if (botReady()) botClick(&difficultyUi, SELECT_EASY + botChoose(DIFFICULTY_COUNT));
 }
 
-void selectCharacter() {
-    bool running = true;
-    SDL_Event event;
-    SDL_Color textColor = {255, 255, 255};
-    SDL_Color buttonColor = {0, 0, 255};
-    SDL_Color hoverColor = {0, 255, 0};
-    SDL_Color selectedColor = {255, 165, 0};
+static void renderDifficulty() {
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, getTexture(menuBackgroundTexture), NULL, NULL);
+    uiRender(&difficultyUi);
+}
 
-    // Rectangle pour le titre
-    SDL_Rect titleRect = {SCREEN_WIDTH / 2 - 200, 20, 400, 50};
-    SDL_Texture* titleText = createTextTexture("Selectionnez votre personnage", textColor);
-
-    // Charger toutes les images des personnages
-    char* characterFiles[] = {
-        "user/astra.png", "user/breach.png", "user/brimstone.png", "user/chamber.png",
-        "user/clove.png", "user/cypher.png", "user/fade.png", "user/gekko.png",
-        "user/harbor.png", "user/iso.png", "user/jett.png", "user/killjoy.png",
-        "user/neon.png", "user/omen.png", "user/phoenix.png", "user/raze.png",
-        "user/reyna.png", "user/sage.png", "user/skye.png", "user/sova.png",
-        "user/viper.png", "user/vyse.png", "user/waylay.png"
-    };
-    int numCharacters = sizeof(characterFiles) / sizeof(characterFiles[0]);
-    SDL_Texture** characterTextures = malloc(numCharacters * sizeof(SDL_Texture*));
-    
-    // Variables pour les animations
-    float* characterScales = malloc(numCharacters * sizeof(float));
-    float* characterPulses = malloc(numCharacters * sizeof(float));
-    Uint32* hoverStartTimes = malloc(numCharacters * sizeof(Uint32));
-    Uint32* selectStartTimes = malloc(numCharacters * sizeof(Uint32));
-    bool* isHovered = malloc(numCharacters * sizeof(bool));
-    
+static const Scene difficultyScene = {
+    .name = "difficulte", .enter = enterDifficulty, .exit = exitDifficulty, .handleEvent = handleDifficultyEvent,
+    .update = updateDifficulty, .render = renderDifficulty
+};
+
+static const char* characterFiles[] = {
+    "user/astra.png", "user/breach.png", "user/brimstone.png", "user/chamber.png",
+    "user/clove.png", "user/cypher.png", "user/fade.png", "user/gekko.png",
+    "user/harbor.png", "user/iso.png", "user/jett.png", "user/killjoy.png",
+    "user/neon.png", "user/omen.png", "user/phoenix.png", "user/raze.png",
+    "user/reyna.png", "user/sage.png", "user/skye.png", "user/sova.png",
+    "user/viper.png", "user/vyse.png", "user/waylay.png"
+};
+#define NUM_CHARACTERS ((int)SDL_arraysize(characterFiles))
+
+enum { CHARACTER_TITLE = 1, CHARACTER_GRID, CHARACTER_CONTINUE };
+
+static const WidgetDef characterWidgets[] = {
+    UI_LABEL(CHARACTER_TITLE, SCREEN_WIDTH / 2 - 200, 20, 400, 50, "Selectionnez votre personnage"),
+    {.type = WIDGET_GRID, .id = CHARACTER_GRID,
+     .rect = {(SCREEN_WIDTH - (CHARACTERS_PER_ROW * (CHARACTER_SIZE + CHARACTER_PADDING))) / 2, 100, 0, 0},
+     .columns = CHARACTERS_PER_ROW, .cellCount = NUM_CHARACTERS, .cellSize = CHARACTER_SIZE, .padding = CHARACTER_PADDING},
+    {.type = WIDGET_BUTTON, .id = CHARACTER_CONTINUE, .rect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT - 80, 200, 60},
+     .text = "Continuer", .textRect = {50, 15, 100, 30}, .radius = 20, .color = UI_BUTTON_COLOR,
+     .hoverColor = UI_HOVER_COLOR, .flags = UI_HIDDEN}
+};
+
+static Ui characterUi;
+// Variables pour les animations
+static float characterScales[NUM_CHARACTERS];
+static float characterPulses[NUM_CHARACTERS];
+static Uint32 selectStartTimes[NUM_CHARACTERS];
+// Portraits déjà décodés au démarrage, rangés dans l'atlas
+static AtlasSprite characterSprites[NUM_CHARACTERS];
+static bool characterLoaded[NUM_CHARACTERS];
+static int selectedIndex = -1;
+
+static bool enterCharacter() {
+    uiLoad(&characterUi, characterWidgets, SDL_arraysize(characterWidgets));
     // Initialiser les animations
-    for (int i = 0; i < numCharacters; i++) {
+    for (int i = 0; i < NUM_CHARACTERS; i++) {
         characterScales[i] = 1.0f;
         characterPulses[i] = 0.0f;
-        hoverStartTimes[i] = 0;
         selectStartTimes[i] = 0;
-        isHovered[i] = false;
-    }
-    
-    // Charger toutes les textures
-    for (int i = 0; i < numCharacters; i++) {
-        characterTextures[i] = loadTexture(characterFiles[i]);
-        if (!characterTextures[i]) {
-            printf("Erreur lors du chargement de l'image: %s\n", characterFiles[i]);
-        }
+        characterLoaded[i] = getAtlasSprite(characterFiles[i], &characterSprites[i]);
     }
+    selectedIndex = -1;
+    return true;
+}
 
-    // Calculer la disposition de la grille
-    int startX = (SCREEN_WIDTH - (CHARACTERS_PER_ROW * (CHARACTER_SIZE + CHARACTER_PADDING))) / 2;
-    int startY = 100;
-    SDL_Rect* characterRects = malloc(numCharacters * sizeof(SDL_Rect));
-    
-    for (int i = 0; i < numCharacters; i++) {
-        int row = i / CHARACTERS_PER_ROW;
-        int col = i % CHARACTERS_PER_ROW;
-        characterRects[i].x = startX + col * (CHARACTER_SIZE + CHARACTER_PADDING);
-        characterRects[i].y = startY + row * (CHARACTER_SIZE + CHARACTER_PADDING);
-        characterRects[i].w = CHARACTER_SIZE;
-        characterRects[i].h = CHARACTER_SIZE;
+static void handleCharacterEvent(const SDL_Event* event) {
+    int clicked = uiHandleEvent(&characterUi, event);
+    if (clicked == CHARACTER_GRID) {
+        // Clic sur un personnage
+        selectedIndex = characterUi.activatedCell;
+        strcpy(selectedCharacter, characterFiles[selectedIndex]);
+        selectStartTimes[selectedIndex] = SDL_GetTicks();
+        uiSetVisible(&characterUi, CHARACTER_CONTINUE, true);
+        Mix_PlayChannel(-1, selectSound, 0); // Jouer le son de sélection
+    } else if (clicked == CHARACTER_CONTINUE) {
+        Mix_PlayChannel(-1, buttonSound, 0); // Jouer le son du bouton
+
+        // Charger la nouvelle texture du joueur
+        // Acquérir avant de libérer : même personnage, aucun rechargement
+        Resource* previousPlayer = playerTexture;
+        playerTexture = acquireResource(RESOURCE_TEXTURE, selectedCharacter);
+        releaseResource(previousPlayer);
+        switchScene(&difficultyScene);
     }
+}
 
-    // Rectangle pour le bouton Continuer
-    SDL_Rect continueButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT - 80, 200, 60};
-    SDL_Texture* continueText = createTextTexture("Continuer", textColor);
-    bool characterSelected = false;
-    int selectedIndex = -1;
-
-    Uint32 lastTime = SDL_GetTicks();
+static void updateCharacter(double deltaTime) {
     const float ANIMATION_SPEED = 0.5f;
     const float PULSE_SPEED = 0.02f;
     const float MAX_SCALE = 1.2f;
     const float MIN_SCALE = 1.0f;
-
-    while (running) {
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
-
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-            } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
-
-                // Vérifier les clics sur les personnages
-                for (int i = 0; i < numCharacters; i++) {
-                    if (x >= characterRects[i].x && x < characterRects[i].x + characterRects[i].w &&
-                        y >= characterRects[i].y && y < characterRects[i].y + characterRects[i].h) {
-                        selectedIndex = i;
-                        characterSelected = true;
-                        strcpy(selectedCharacter, characterFiles[i]);
-                        selectStartTimes[i] = currentTime;
-                        Mix_PlayChannel(-1, selectSound, 0); // Jouer le son de sélection
-                        break;
-                    }
-                }
-
-                // Vérifier le clic sur le bouton Continuer
-                if (characterSelected && x >= continueButtonRect.x && x < continueButtonRect.x + continueButtonRect.w &&
-                    y >= continueButtonRect.y && y < continueButtonRect.y + continueButtonRect.h) {
-                    Mix_PlayChannel(-1, buttonSound, 0); // Jouer le son du bouton
-                    running = false;
-                    
-                    // Nettoyer les ressources
-                    SDL_DestroyTexture(titleText);
-                    SDL_DestroyTexture(continueText);
-                    for (int i = 0; i < numCharacters; i++) {
-                        SDL_DestroyTexture(characterTextures[i]);
-                    }
-                    free(characterTextures);
-                    free(characterRects);
-                    free(characterScales);
-                    free(characterPulses);
-                    free(hoverStartTimes);
-                    free(selectStartTimes);
-                    free(isHovered);
-                    
-                    // Charger la nouvelle texture du joueur
-                    if (playerTexture) {
-                        SDL_DestroyTexture(playerTexture);
-                    }
-                    playerTexture = loadTexture(selectedCharacter);
-                    selectDifficulty();
-                    return;
-                }
-            }
+    Uint32 currentTime = SDL_GetTicks();
+
+    // Mise à jour des animations, le survol est suivi par la couche d'interface
+    int hoveredCharacter = uiIsHovered(&characterUi, CHARACTER_GRID) ? characterUi.hoveredCell : -1;
+    for (int i = 0; i < NUM_CHARACTERS; i++) {
+        // Animation de zoom au survol
+        float targetScale = (i == hoveredCharacter) ? MAX_SCALE : MIN_SCALE;
+        characterScales[i] += (targetScale - characterScales[i]) * ANIMATION_SPEED * deltaTime;
+
+        // Animation de pulse pour le personnage sélectionné
+        if (i == selectedIndex) {
+            characterPulses[i] = sin((currentTime - selectStartTimes[i]) * PULSE_SPEED) * 0.1f + 1.0f;
+        } else {
+            characterPulses[i] = 1.0f;
         }
+    }
 
-        // Mise à jour des animations
-        int x, y;
-        SDL_GetMouseState(&x, &y);
+    // Le bot choisit un personnage au hasard, puis continue
+    if (botReady()) {
+        if (selectedIndex < 0) {
+            botClickCell(&characterUi, CHARACTER_GRID, botChoose(NUM_CHARACTERS));
+        } else {
+            botClick(&characterUi, CHARACTER_CONTINUE);
+        }
+    }
+}
 
-        for (int i = 0; i < numCharacters; i++) {
-            bool isHovering = (x >= characterRects[i].x && x < characterRects[i].x + characterRects[i].w &&
-                             y >= characterRects[i].y && y < characterRects[i].y + characterRects[i].h);
+static void renderCharacter() {
+    SDL_Color selectedColor = {255, 165, 0};
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, getTexture(menuBackgroundTexture), NULL, NULL);
 
-            // Animation de survol
-            if (isHovering != isHovered[i]) {
-                isHovered[i] = isHovering;
-                hoverStartTimes[i] = currentTime;
-            }
+    // Afficher tous les personnages avec animations : fond du personnage
+    // sélectionné d'abord, puis tous les portraits en un seul lot
+    for (int i = 0; i < NUM_CHARACTERS; i++) {
+        SDL_Rect destRect = uiGetCellRect(&characterUi, CHARACTER_GRID, i);
+        float finalScale = characterScales[i] * characterPulses[i];
 
-            // Animation de zoom au survol
-            float targetScale = isHovering ? MAX_SCALE : MIN_SCALE;
-            characterScales[i] += (targetScale - characterScales[i]) * ANIMATION_SPEED * deltaTime;
+        // Calculer la nouvelle taille et position pour l'effet de zoom
+        int newWidth = destRect.w * finalScale;
+        int newHeight = destRect.h * finalScale;
+        int offsetX = (newWidth - destRect.w) / 2;
+        int offsetY = (newHeight - destRect.h) / 2;
 
-            // Animation de pulse pour le personnage sélectionné
-            if (i == selectedIndex) {
-                characterPulses[i] = sin((currentTime - selectStartTimes[i]) * PULSE_SPEED) * 0.1f + 1.0f;
-            } else {
-                characterPulses[i] = 1.0f;
-            }
-        }
+        SDL_Rect scaledRect = {
+            destRect.x - offsetX,
+            destRect.y - offsetY,
+            newWidth,
+            newHeight
+        };
 
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
-
-        // Afficher le titre
-        SDL_RenderCopy(renderer, titleText, NULL, &titleRect);
-
-        // Afficher tous les personnages avec animations
-        for (int i = 0; i < numCharacters; i++) {
-            SDL_Rect destRect = characterRects[i];
-            float finalScale = characterScales[i] * characterPulses[i];
-            
-            // Calculer la nouvelle taille et position pour l'effet de zoom
-            int newWidth = destRect.w * finalScale;
-            int newHeight = destRect.h * finalScale;
-            int offsetX = (newWidth - destRect.w) / 2;
-            int offsetY = (newHeight - destRect.h) / 2;
-            
-            SDL_Rect scaledRect = {
-                destRect.x - offsetX,
-                destRect.y - offsetY,
-                newWidth,
-                newHeight
-            };
-
-            // Afficher l'image du personnage avec un fond orange si sélectionné
-            if (i == selectedIndex) {
-                SDL_SetRenderDrawColor(renderer, selectedColor.r, selectedColor.g, selectedColor.b, 255);
-                SDL_RenderFillRect(renderer, &scaledRect);
-            }
-            
-            if (characterTextures[i]) {
-                SDL_RenderCopy(renderer, characterTextures[i], NULL, &scaledRect);
-            }
+        // Afficher l'image du personnage avec un fond orange si sélectionné
+        if (i == selectedIndex) {
+            SDL_SetRenderDrawColor(renderer, selectedColor.r, selectedColor.g, selectedColor.b, 255);
+            SDL_RenderFillRect(renderer, &scaledRect);
         }
 
-        // Afficher le bouton Continuer
-        if (characterSelected) {
-            int x, y;
-            SDL_GetMouseState(&x, &y);
-            if (x >= continueButtonRect.x && x < continueButtonRect.x + continueButtonRect.w &&
-                y >= continueButtonRect.y && y < continueButtonRect.y + continueButtonRect.h) {
-                drawRoundedRect(renderer, continueButtonRect, 20, hoverColor);
-            } else {
-                drawRoundedRect(renderer, continueButtonRect, 20, buttonColor);
-            }
-            SDL_Rect continueTextRect = {continueButtonRect.x + 50, continueButtonRect.y + 15, 100, 30};
-            SDL_RenderCopy(renderer, continueText, NULL, &continueTextRect);
+        if (characterLoaded[i]) {
+            SDL_FRect spriteRect = {scaledRect.x, scaledRect.y, scaledRect.w, scaledRect.h};
+            drawSprite(characterSprites[i].texture, &characterSprites[i].src, spriteRect, 0.0f, SPRITE_WHITE);
         }
-
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
     }
+    flushSprites();
 
-    // Nettoyer les ressources
-    SDL_DestroyTexture(titleText);
-    SDL_DestroyTexture(continueText);
-    for (int i = 0; i < numCharacters; i++) {
-        SDL_DestroyTexture(characterTextures[i]);
-    }
-    free(characterTextures);
-    free(characterRects);
-    free(characterScales);
-    free(characterPulses);
-    free(hoverStartTimes);
-    free(selectStartTimes);
-    free(isHovered);
+    // Titre et bouton Continuer
+    uiRender(&characterUi);
+}
+
+static const Scene characterScene = {
+    .name = "personnages", .enter = enterCharacter, .handleEvent = handleCharacterEvent,
+    .update = updateCharacter, .render = renderCharacter
+};
+
+// Textures indispensables au démarrage : le chargement asynchrone renvoie une
+// ressource même pour un fichier absent, l'échec n'apparaît qu'une fois décodée
+static bool waitForTexture(Resource* resource) {
+    if (!resource) return false;
+    waitForImage(resource->image);
+    if (isImageReady(resource->image)) return true;
+    printf("Texture indispensable introuvable : %s\n", resource->path);
+    return false;
 }
 
 int main(int argc, char* argv[]) {
+    // Cadence d'affichage : --vsync, --uncapped ou --fps N (60 par défaut)
+    PacingMode pacingMode = PACING_CAPPED;
+    int targetFps = DEFAULT_FPS;
+    int jobThreads = 0; // --threads N, un par cœur par défaut
+    const ScoreStore* scoreStore = &mysqlScoreStore; // --scores sqlite : fichier local, sans serveur
+    const char* importPath = NULL; // --import scores.csv : charge un historique puis quitte
+    bool botMode = false;          // --bot : joueur automatique pour les essais d'endurance
+    int botMinutes = 0;            // --bot-minutes N : quitte ensuite, sans limite par défaut
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--vsync") == 0) {
+            pacingMode = PACING_VSYNC;
+        } else if (strcmp(argv[i], "--uncapped") == 0) {
+            pacingMode = PACING_UNCAPPED;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            targetFps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--balls") == 0 && i + 1 < argc) {
+            stressBallCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--collisions") == 0) {
+            ballCollisionMode = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            jobThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--import") == 0 && i + 1 < argc) {
+            importPath = argv[++i];
+        } else if (strcmp(argv[i], "--scores-ttl") == 0 && i + 1 < argc) {
+            setLeaderboardTtl(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay-speed") == 0 && i + 1 < argc) {
+            replayMaxSpeed = strcmp(argv[++i], "max") == 0;
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            botMode = true;
+        } else if (strcmp(argv[i], "--bot-minutes") == 0 && i + 1 < argc) {
+            botMode = true;
+            botMinutes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scores") == 0 && i + 1 < argc) {
+            scoreStore = strcmp(argv[++i], "sqlite") == 0 ? &sqliteScoreStore : &mysqlScoreStore;
+        }
+    }
+
+    if (importPath) {
+        return importScores(scoreStore, importPath) < 0 ? 1 : 0;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0 || 
         IMG_Init(IMG_INIT_PNG) == 0 || 
         TTF_Init() == -1 ||
@@ -1309,42 +934,79 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     window = SDL_CreateWindow("Jeu SDL2", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+    if (pacingMode == PACING_VSYNC) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+    if (window && !renderer) {
+        // Pilote vidéo factice (SDL_VIDEODRIVER=dummy) : seul le rendu logiciel existe
+        rendererFlags = (rendererFlags & ~SDL_RENDERER_ACCELERATED) | SDL_RENDERER_SOFTWARE;
+        renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+    }
     if (!window || !renderer) {
         printf("Erreur de création de fenêtre/renderer : %s\n", SDL_GetError());
         return 1;
     }
-    playerTexture = loadTexture("user/phoenix.png"); // Charger un personnage par défaut
-    backgroundTexture = loadTexture("background.png");
-    menuBackgroundTexture = loadTexture("menu_background.png");
-    ballTexture = loadTexture("Smoke.png");
-    if (!playerTexture || !backgroundTexture || !menuBackgroundTexture || !ballTexture) return 1;
-
-    MYSQL *con = mysql_init(NULL);
-    if (con == NULL) {
-        fprintf(stderr, "mysql_init() failed\n");
+    // Paquet pré-décodé de `make pack`, sinon fichiers d'origine
+    if (openPack(PACK_PATH)) printf("Ressources : %s\n", PACK_PATH);
+    if (!initText(renderer)) {
+        printf("Erreur d'initialisation du texte\n");
         return 1;
     }
-    if (mysql_real_connect(con, "localhost", "root", "", NULL, 0, NULL, 0) == NULL) {
-        finish_with_error(con);
+    initUi(renderer);
+    if (!initSprites(renderer)) return 1;
+    if (!initLoader(renderer)) return 1;
+    // Portraits et icônes décodés une seule fois, dans une ou deux textures
+    const char* atlasPaths[MAX_ATLAS_ENTRIES];
+    int atlasCount = 0;
+    for (int i = 0; i < NUM_CHARACTERS; i++) {
+        atlasPaths[atlasCount++] = characterFiles[i];
+    }
+    atlasPaths[atlasCount++] = "button_icon.png";
+    atlasPaths[atlasCount++] = "button_icon2.png";
+    buildAtlas(renderer, atlasPaths, atlasCount);
+    initFramePacing(pacingMode, targetFps);
+    initJobPool(jobThreads);
+    printf("Physique : %s, %d thread(s)\n", getPhysicsBackendName(), getJobThreadCount());
+    playerTexture = acquireResource(RESOURCE_TEXTURE, "user/phoenix.png"); // Charger un personnage par défaut
+    menuBackgroundTexture = acquireResource(RESOURCE_TEXTURE, "menu_background.png");
+    if (!waitForTexture(playerTexture) || !waitForTexture(menuBackgroundTexture)) return 1;
+
+    // Connexion gardée ouverte pour toute la session ; sans serveur, le jeu reste jouable
+    if (openScoreStore(scoreStore)) {
+        printf("Scores : %s\n", scoreStore->name);
+    } else {
+        printf("Scores %s indisponibles, nouvelle tentative a chaque requete\n", scoreStore->name);
     }
-    createDatabase(con);
-    mysql_close(con);
 
     initAudio();
 
-    displayMenu();
-
-    SDL_DestroyTexture(playerTexture);
-    SDL_DestroyTexture(backgroundTexture);
-    SDL_DestroyTexture(menuBackgroundTexture);
-    SDL_DestroyTexture(ballTexture); // Nettoyer la texture des balles
+    // Boucle principale unique : les écrans se remplacent sans s'appeler
+    if (replayPath) {
+        runScenes(renderer, &replayScene);
+    } else {
+        if (botMode) startBot(botMinutes);
+        runScenes(renderer, &menuScene);
+        stopBot();
+    }
+    PROFILE_DUMP(PROFILE_TRACE_PATH);
+
+    releaseResource(playerTexture);
+    releaseResource(menuBackgroundTexture);
+    printf("Ressources chargees : %d\n", getResourceLoadCount());
+    cleanupUi();
+    cleanupDraw();
+    cleanupSprites();
+    cleanupAtlas();
+    cleanupText();
+    cleanupAudio();
+    cleanupLoader();
+    closePack();
+    closeScoreStore();
+    shutdownJobPool();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     IMG_Quit();
     TTF_Quit();
     SDL_Quit();
-
-    cleanupAudio();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "grid.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int cellIndex(float x, float y) {
+    int column = (int)(x / GRID_CELL_SIZE);
+    int row = (int)(y / GRID_CELL_SIZE);
+    if (column < 0) column = 0;
+    if (column >= GRID_COLUMNS) column = GRID_COLUMNS - 1;
+    if (row < 0) row = 0;
+    if (row >= GRID_ROWS) row = GRID_ROWS - 1;
+    return row * GRID_COLUMNS + column;
+}
+
+static void linkBall(BallGrid* grid, int ball, int cell) {
+    int head = grid->cellHead[cell];
+    grid->prev[ball] = -1;
+    grid->next[ball] = head;
+    if (head >= 0) grid->prev[head] = ball;
+    grid->cellHead[cell] = ball;
+    grid->cellOf[ball] = cell;
+}
+
+static void unlinkBall(BallGrid* grid, int ball) {
+    int cell = grid->cellOf[ball];
+    if (grid->prev[ball] >= 0) {
+        grid->next[grid->prev[ball]] = grid->next[ball];
+    } else {
+        grid->cellHead[cell] = grid->next[ball];
+    }
+    if (grid->next[ball] >= 0) grid->prev[grid->next[ball]] = grid->prev[ball];
+}
+
+bool initGrid(BallGrid* grid, const BallArrays* balls) {
+    memset(grid, 0, sizeof(BallGrid));
+    int count = balls->count > 0 ? balls->count : 1;
+    grid->next = malloc(count * sizeof(int));
+    grid->prev = malloc(count * sizeof(int));
+    grid->cellOf = malloc(count * sizeof(int));
+    grid->targetCell = malloc(count * sizeof(int));
+    if (!grid->next || !grid->prev || !grid->cellOf || !grid->targetCell) {
+        printf("Erreur d'allocation memoire pour la grille\n");
+        freeGrid(grid);
+        return false;
+    }
+    grid->count = balls->count;
+    for (int i = 0; i < GRID_CELLS; i++) {
+        grid->cellHead[i] = -1;
+        // Phase selon la parité de la ligne et la colonne modulo 3
+        int phase = (i / GRID_COLUMNS % 2) * 3 + i % GRID_COLUMNS % 3;
+        grid->phaseCells[phase][grid->phaseCellCount[phase]++] = i;
+    }
+    for (int i = 0; i < balls->count; i++) {
+        linkBall(grid, i, cellIndex(balls->x[i], balls->y[i]));
+    }
+    return true;
+}
+
+void freeGrid(BallGrid* grid) {
+    free(grid->next);
+    free(grid->prev);
+    free(grid->cellOf);
+    free(grid->targetCell);
+    memset(grid, 0, sizeof(BallGrid));
+}
+
+// Calcul des cases, indépendant d'une balle à l'autre (parallélisable)
+void computeGridCellRange(BallGrid* grid, const BallArrays* balls, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        grid->targetCell[i] = cellIndex(balls->x[i], balls->y[i]);
+    }
+}
+
+// Mise à jour incrémentale : seules les balles qui ont changé de case sont
+// déplacées d'une liste à l'autre, toujours dans l'ordre des indices
+void relinkGrid(BallGrid* grid) {
+    for (int i = 0; i < grid->count; i++) {
+        if (grid->targetCell[i] != grid->cellOf[i]) {
+            unlinkBall(grid, i);
+            linkBall(grid, i, grid->targetCell[i]);
+        }
+    }
+}
+
+void updateGrid(BallGrid* grid, const BallArrays* balls) {
+    computeGridCellRange(grid, balls, 0, grid->count);
+    relinkGrid(grid);
+}
+
+// Choc élastique entre masses égales : les deux balles échangent la
+// composante de leur vitesse relative portée par l'axe des centres
+static void collidePair(BallArrays* balls, int i, int j) {
+    const float contactDistance = (float)(GRID_CELL_SIZE * GRID_CELL_SIZE);
+    float offsetX = balls->x[i] - balls->x[j];
+    float offsetY = balls->y[i] - balls->y[j];
+    float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+    if (distanceSquared >= contactDistance || distanceSquared == 0.0f) return;
+    float approach = (balls->dx[i] - balls->dx[j]) * offsetX + (balls->dy[i] - balls->dy[j]) * offsetY;
+    if (approach >= 0.0f) return; // Les balles s'éloignent déjà
+    float impulse = approach / distanceSquared;
+    balls->dx[i] -= impulse * offsetX;
+    balls->dy[i] -= impulse * offsetY;
+    balls->dx[j] += impulse * offsetX;
+    balls->dy[j] += impulse * offsetY;
+}
+
+static void resolveCell(const BallGrid* grid, BallArrays* balls, int cell) {
+    // Voisines en avant : droite, puis les trois cases de la ligne suivante
+    static const int forwardColumns[4] = {1, -1, 0, 1};
+    static const int forwardRows[4] = {0, 1, 1, 1};
+    int column = cell % GRID_COLUMNS;
+    int row = cell / GRID_COLUMNS;
+    for (int i = grid->cellHead[cell]; i >= 0; i = grid->next[i]) {
+        for (int j = grid->next[i]; j >= 0; j = grid->next[j]) {
+            collidePair(balls, i, j);
+        }
+        for (int k = 0; k < 4; k++) {
+            int neighborColumn = column + forwardColumns[k];
+            int neighborRow = row + forwardRows[k];
+            if (neighborColumn < 0 || neighborColumn >= GRID_COLUMNS || neighborRow >= GRID_ROWS) continue;
+            for (int j = grid->cellHead[neighborRow * GRID_COLUMNS + neighborColumn]; j >= 0; j = grid->next[j]) {
+                collidePair(balls, i, j);
+            }
+        }
+    }
+}
+
+// Traite les cases [begin, end) d'une phase ; l'ordre des phases est fixe,
+// l'ordre des cases à l'intérieur d'une phase n'influe pas sur le résultat
+void resolvePhaseRange(const BallGrid* grid, BallArrays* balls, int phase, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        resolveCell(grid, balls, grid->phaseCells[phase][i]);
+    }
+}
+
+void resolveBallCollisions(BallGrid* grid, BallArrays* balls) {
+    updateGrid(grid, balls);
+    for (int phase = 0; phase < GRID_PHASES; phase++) {
+        resolvePhaseRange(grid, balls, phase, 0, grid->phaseCellCount[phase]);
+    }
+}
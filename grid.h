@@ -0,0 +1,39 @@
+#ifndef GRID_H
+#define GRID_H
+
+// Grille uniforme pour les collisions entre balles : une case fait le
+// diamètre d'une balle, donc deux balles en contact sont toujours dans
+// des cases voisines.
+
+#include <stdbool.h>
+#include "physics.h"
+
+#define GRID_CELL_SIZE (BALL_RADIUS * 2)
+#define GRID_COLUMNS ((WORLD_WIDTH + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+#define GRID_ROWS ((WORLD_HEIGHT + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+#define GRID_CELLS (GRID_ROWS * GRID_COLUMNS)
+// Une case traite ses paires avec elle-même et ses voisines "en avant"
+// (2 lignes x 3 colonnes) ; deux cases de la même phase n'ont aucune balle
+// en commun et peuvent être traitées dans n'importe quel ordre
+#define GRID_PHASES 6
+
+typedef struct {
+    int cellHead[GRID_CELLS]; // Première balle de chaque case, -1 si vide
+    int* next;     // Listes chaînées intrusives des balles d'une même case
+    int* prev;
+    int* cellOf;   // Case actuelle de chaque balle
+    int* targetCell; // Case calculée pour ce pas, avant mise à jour des listes
+    int count;
+    int phaseCells[GRID_PHASES][GRID_CELLS];
+    int phaseCellCount[GRID_PHASES];
+} BallGrid;
+
+bool initGrid(BallGrid* grid, const BallArrays* balls);
+void freeGrid(BallGrid* grid);
+void computeGridCellRange(BallGrid* grid, const BallArrays* balls, int begin, int end);
+void relinkGrid(BallGrid* grid);
+void updateGrid(BallGrid* grid, const BallArrays* balls);
+void resolvePhaseRange(const BallGrid* grid, BallArrays* balls, int phase, int begin, int end);
+void resolveBallCollisions(BallGrid* grid, BallArrays* balls);
+
+#endif
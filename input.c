@@ -0,0 +1,46 @@
+#include "input.h"
+
+static InputSource inputSource = NULL;
+
+void setInputSource(InputSource source) {
+    inputSource = source;
+}
+
+static SimInput readKeyboard() {
+    const Uint8* keys = SDL_GetKeyboardState(NULL);
+    SimInput input = 0;
+    if (keys[SDL_SCANCODE_UP]) input |= INPUT_UP;
+    if (keys[SDL_SCANCODE_DOWN]) input |= INPUT_DOWN;
+    if (keys[SDL_SCANCODE_LEFT]) input |= INPUT_LEFT;
+    if (keys[SDL_SCANCODE_RIGHT]) input |= INPUT_RIGHT;
+    return input;
+}
+
+// Flèches enfoncées pour la frame en cours, lues une fois avant les pas de simulation
+SimInput readPlayerInput(const Simulation* sim) {
+    return inputSource ? inputSource(sim) : readKeyboard();
+}
+
+// Déplacement puis clic gauche complet : le survol et l'activation passent
+// par uiHandleEvent exactement comme avec une vraie souris
+void pushClick(int x, int y) {
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_MOUSEMOTION;
+    event.motion.x = x;
+    event.motion.y = y;
+    SDL_PushEvent(&event);
+
+    SDL_zero(event);
+    event.type = SDL_MOUSEBUTTONDOWN;
+    event.button.button = SDL_BUTTON_LEFT;
+    event.button.state = SDL_PRESSED;
+    event.button.clicks = 1;
+    event.button.x = x;
+    event.button.y = y;
+    SDL_PushEvent(&event);
+
+    event.type = SDL_MOUSEBUTTONUP;
+    event.button.state = SDL_RELEASED;
+    SDL_PushEvent(&event);
+}
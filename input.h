@@ -0,0 +1,18 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Entrées du joueur : la partie lit sa direction ici plutôt que directement
+// dans l'état du clavier, pour qu'une autre source (le bot de --bot) puisse
+// la remplacer. Les menus restent pilotés par les événements SDL : pushClick
+// en ajoute de synthétiques dans la file, lus comme ceux de la souris.
+
+#include <SDL.h>
+#include "sim.h"
+
+typedef SimInput (*InputSource)(const Simulation* sim);
+
+void setInputSource(InputSource source); // NULL : retour au clavier
+SimInput readPlayerInput(const Simulation* sim);
+void pushClick(int x, int y);
+
+#endif
@@ -0,0 +1,203 @@
+#include "jobs.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define JOB_SPIN_COUNT 20000 // Attente active avant de s'endormir entre deux boucles
+
+// File d'un thread : intervalle de morceaux [begin, end) packé dans un mot,
+// le propriétaire prend par le début, les voleurs par la fin
+typedef struct {
+    _Atomic uint64_t range;
+    char padding[64 - sizeof(uint64_t)]; // Une ligne de cache par file
+} JobQueue;
+
+static pthread_t workers[MAX_JOB_THREADS];
+static JobQueue queues[MAX_JOB_THREADS];
+static int jobThreadCount = 1; // Thread principal compris
+static bool poolStarted = false;
+
+static JobFunc currentFunc;
+static void* currentContext;
+static int currentCount;
+static int currentGrain;
+static atomic_int remainingChunks;
+static atomic_uint generation;
+static atomic_int sleepingWorkers;
+static atomic_bool stopping;
+static pthread_mutex_t wakeMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wakeCondition = PTHREAD_COND_INITIALIZER;
+
+static uint64_t packRange(uint32_t begin, uint32_t end) {
+    return ((uint64_t)end << 32) | begin;
+}
+
+static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    sched_yield();
+#endif
+}
+
+static bool popFront(JobQueue* queue, int* chunk) {
+    uint64_t range = atomic_load(&queue->range);
+    for (;;) {
+        uint32_t begin = (uint32_t)range;
+        uint32_t end = (uint32_t)(range >> 32);
+        if (begin >= end) return false;
+        if (atomic_compare_exchange_weak(&queue->range, &range, packRange(begin + 1, end))) {
+            *chunk = (int)begin;
+            return true;
+        }
+    }
+}
+
+static bool stealBack(JobQueue* queue, int* chunk) {
+    uint64_t range = atomic_load(&queue->range);
+    for (;;) {
+        uint32_t begin = (uint32_t)range;
+        uint32_t end = (uint32_t)(range >> 32);
+        if (begin >= end) return false;
+        if (atomic_compare_exchange_weak(&queue->range, &range, packRange(begin, end - 1))) {
+            *chunk = (int)(end - 1);
+            return true;
+        }
+    }
+}
+
+// Vide sa propre file puis vole dans celles des autres jusqu'à ce que tout
+// soit pris
+static void runChunks(int self) {
+    int chunk;
+    for (;;) {
+        bool found = popFront(&queues[self], &chunk);
+        for (int k = 1; !found && k < jobThreadCount; k++) {
+            found = stealBack(&queues[(self + k) % jobThreadCount], &chunk);
+        }
+        if (!found) return;
+        int begin = chunk * currentGrain;
+        int end = begin + currentGrain < currentCount ? begin + currentGrain : currentCount;
+        currentFunc(currentContext, begin, end, chunk);
+        atomic_fetch_sub(&remainingChunks, 1);
+    }
+}
+
+static void* workerMain(void* argument) {
+    int self = (int)(intptr_t)argument;
+    unsigned seen = 0;
+    for (;;) {
+        int spins = 0;
+        while (atomic_load(&generation) == seen && !atomic_load(&stopping)) {
+            if (++spins < JOB_SPIN_COUNT) {
+                cpuRelax();
+                continue;
+            }
+            atomic_fetch_add(&sleepingWorkers, 1);
+            pthread_mutex_lock(&wakeMutex);
+            while (atomic_load(&generation) == seen && !atomic_load(&stopping)) {
+                pthread_cond_wait(&wakeCondition, &wakeMutex);
+            }
+            pthread_mutex_unlock(&wakeMutex);
+            atomic_fetch_sub(&sleepingWorkers, 1);
+        }
+        if (atomic_load(&stopping)) break;
+        seen = atomic_load(&generation);
+        runChunks(self);
+    }
+    return NULL;
+}
+
+// threadCount <= 0 : un thread par cœur
+bool initJobPool(int threadCount) {
+    if (poolStarted) return true;
+    if (threadCount <= 0) threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_JOB_THREADS) threadCount = MAX_JOB_THREADS;
+    atomic_store(&stopping, false);
+    jobThreadCount = 1;
+    for (int i = 1; i < threadCount; i++) {
+        if (pthread_create(&workers[i], NULL, workerMain, (void*)(intptr_t)i) != 0) {
+            printf("Impossible de creer le thread de calcul %d\n", i);
+            break;
+        }
+        jobThreadCount++;
+    }
+    poolStarted = true;
+    return jobThreadCount == threadCount;
+}
+
+void shutdownJobPool() {
+    if (!poolStarted) return;
+    pthread_mutex_lock(&wakeMutex);
+    atomic_store(&stopping, true);
+    pthread_cond_broadcast(&wakeCondition);
+    pthread_mutex_unlock(&wakeMutex);
+    for (int i = 1; i < jobThreadCount; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    jobThreadCount = 1;
+    poolStarted = false;
+}
+
+int getJobThreadCount() {
+    return jobThreadCount;
+}
+
+// Morceaux agrandis si nécessaire pour ne pas dépasser MAX_JOB_CHUNKS
+static int effectiveGrain(int count, int grain) {
+    int minGrain = (count + MAX_JOB_CHUNKS - 1) / MAX_JOB_CHUNKS;
+    if (grain < minGrain) grain = minGrain;
+    return grain < 1 ? 1 : grain;
+}
+
+int getJobChunkCount(int count, int grain) {
+    if (count <= 0) return 0;
+    grain = effectiveGrain(count, grain);
+    return (count + grain - 1) / grain;
+}
+
+// Découpe [0, count) en morceaux de grain indices et les exécute sur le pool ;
+// le thread appelant participe et ne revient qu'une fois tout terminé.
+// Le découpage ne dépend que de count et grain, jamais du nombre de threads.
+void parallelFor(int count, int grain, JobFunc func, void* context) {
+    if (count <= 0) return;
+    int chunkCount = getJobChunkCount(count, grain);
+    grain = effectiveGrain(count, grain);
+    if (jobThreadCount == 1 || chunkCount == 1) {
+        for (int chunk = 0; chunk < chunkCount; chunk++) {
+            int begin = chunk * grain;
+            func(context, begin, begin + grain < count ? begin + grain : count, chunk);
+        }
+        return;
+    }
+
+    currentFunc = func;
+    currentContext = context;
+    currentCount = count;
+    currentGrain = grain;
+    atomic_store(&remainingChunks, chunkCount);
+    // Répartition initiale en blocs contigus, rééquilibrée ensuite par le vol
+    for (int i = 0; i < jobThreadCount; i++) {
+        uint32_t begin = (uint32_t)((int64_t)chunkCount * i / jobThreadCount);
+        uint32_t end = (uint32_t)((int64_t)chunkCount * (i + 1) / jobThreadCount);
+        atomic_store(&queues[i].range, packRange(begin, end));
+    }
+    atomic_fetch_add(&generation, 1);
+    if (atomic_load(&sleepingWorkers) > 0) {
+        pthread_mutex_lock(&wakeMutex);
+        pthread_cond_broadcast(&wakeCondition);
+        pthread_mutex_unlock(&wakeMutex);
+    }
+
+    runChunks(0);
+    int spins = 0;
+    while (atomic_load(&remainingChunks) > 0) {
+        // Un morceau volé peut appartenir à un thread en attente du processeur
+        if (++spins < JOB_SPIN_COUNT) cpuRelax();
+        else sched_yield();
+    }
+}
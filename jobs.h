@@ -0,0 +1,22 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+// Pool de threads à vol de tâches pour découper les boucles de la
+// simulation. Sans SDL : fait partie de libvalosim.a.
+
+#include <stdbool.h>
+
+#define MAX_JOB_THREADS 64
+#define MAX_JOB_CHUNKS 1024
+
+// Traite les indices [begin, end) ; chunk est le numéro du morceau, de 0 à
+// chunkCount - 1, pour ranger un résultat partiel à une place fixe
+typedef void (*JobFunc)(void* context, int begin, int end, int chunk);
+
+bool initJobPool(int threadCount);
+void shutdownJobPool();
+int getJobThreadCount();
+int getJobChunkCount(int count, int grain);
+void parallelFor(int count, int grain, JobFunc func, void* context);
+
+#endif
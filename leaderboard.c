@@ -0,0 +1,65 @@
+#include "leaderboard.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static Leaderboard boards[MAX_LEADERBOARDS];
+static int boardCount = 0;
+static uint64_t ttlMilliseconds = DEFAULT_LEADERBOARD_TTL * 1000ULL;
+
+static uint64_t nowMilliseconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+void setLeaderboardTtl(int seconds) {
+    ttlMilliseconds = seconds > 0 ? (uint64_t)seconds * 1000 : 0;
+}
+
+// Crée l'entrée vide au premier appel ; NULL seulement si la table est pleine
+Leaderboard* getLeaderboard(const char* difficulte) {
+    for (int i = 0; i < boardCount; i++) {
+        if (strcmp(boards[i].difficulte, difficulte) == 0) return &boards[i];
+    }
+    if (boardCount == MAX_LEADERBOARDS) return NULL;
+    Leaderboard* board = &boards[boardCount++];
+    memset(board, 0, sizeof(Leaderboard));
+    snprintf(board->difficulte, sizeof(board->difficulte), "%s", difficulte);
+    return board;
+}
+
+bool isLeaderboardFresh(const Leaderboard* board) {
+    if (!board->loaded) return false;
+    return ttlMilliseconds == 0 || nowMilliseconds() - board->loadedAt < ttlMilliseconds;
+}
+
+void fillLeaderboard(Leaderboard* board, const Score* scores, int count) {
+    board->count = count < LEADERBOARD_SIZE ? count : LEADERBOARD_SIZE;
+    memcpy(board->scores, scores, board->count * sizeof(Score));
+    board->loaded = true;
+    board->loadedAt = nowMilliseconds();
+}
+
+// Insertion à sa place dans le classement déjà chargé, sans requête.
+// À temps égal, le score le plus récent passe avant les anciens, comme dans
+// l'ordre de la base (Time DESC, Id DESC).
+void addLeaderboardScore(const Score* score) {
+    Leaderboard* board = getLeaderboard(score->difficulte);
+    if (!board || !board->loaded) return; // Sera lu avec le prochain chargement
+    int position = board->count;
+    while (position > 0 && board->scores[position - 1].time <= score->time) {
+        position--;
+    }
+    if (position >= LEADERBOARD_SIZE) return;
+    int moved = (board->count < LEADERBOARD_SIZE ? board->count : LEADERBOARD_SIZE - 1) - position;
+    memmove(&board->scores[position + 1], &board->scores[position], moved * sizeof(Score));
+    board->scores[position] = *score;
+    if (board->count < LEADERBOARD_SIZE) board->count++;
+}
+
+void invalidateLeaderboards() {
+    for (int i = 0; i < boardCount; i++) {
+        boards[i].loaded = false;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+// Classements gardés en mémoire, un par difficulté : chargés une fois depuis
+// la base, tenus à jour à chaque score soumis localement, et rechargés après
+// LEADERBOARD_TTL secondes pour voir les scores écrits par d'autres machines.
+// Utilisé uniquement depuis le thread principal.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scorestore.h"
+
+#define LEADERBOARD_SIZE 10
+#define MAX_LEADERBOARDS 8
+#define DEFAULT_LEADERBOARD_TTL 60 // Secondes
+
+typedef struct {
+    char difficulte[20];
+    Score scores[LEADERBOARD_SIZE]; // Du meilleur temps au moins bon
+    int count;
+    bool loaded;
+    uint64_t loadedAt;              // Millisecondes, horloge monotone
+} Leaderboard;
+
+void setLeaderboardTtl(int seconds); // 0 : jamais rechargé
+Leaderboard* getLeaderboard(const char* difficulte);
+bool isLeaderboardFresh(const Leaderboard* board);
+void fillLeaderboard(Leaderboard* board, const Score* scores, int count);
+void addLeaderboardScore(const Score* score);
+void invalidateLeaderboards();
+
+#endif
@@ -0,0 +1,250 @@
+#include "loader.h"
+#include "pack.h"
+#include "profile.h"
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static SDL_Renderer* loaderRenderer = NULL;
+static SDL_Thread* loaderThreads[MAX_LOADER_THREADS];
+static int loaderThreadCount = 0;
+static SDL_mutex* loaderMutex = NULL;
+static SDL_cond* requestCondition = NULL;  // Réveille les threads de décodage
+static SDL_cond* decodedCondition = NULL;  // Réveille waitForImage
+static AsyncImage* requestHead = NULL;     // Files FIFO protégées par loaderMutex
+static AsyncImage* requestTail = NULL;
+static AsyncImage* decodedHead = NULL;
+static AsyncImage* decodedTail = NULL;
+static bool loaderStopping = false;
+static SDL_Texture* placeholderTexture = NULL;
+static int imageTextureCount = 0; // Textures d'images vivantes, créées et détruites par le thread principal
+
+static void pushImage(AsyncImage** head, AsyncImage** tail, AsyncImage* image) {
+    image->next = NULL;
+    if (*tail) (*tail)->next = image;
+    else *head = image;
+    *tail = image;
+}
+
+static AsyncImage* popImage(AsyncImage** head, AsyncImage** tail) {
+    AsyncImage* image = *head;
+    if (image) {
+        *head = image->next;
+        if (!*head) *tail = NULL;
+        image->next = NULL;
+    }
+    return image;
+}
+
+static void freeImage(AsyncImage* image) {
+    if (image->surface) SDL_FreeSurface(image->surface);
+    if (image->texture) {
+        SDL_DestroyTexture(image->texture);
+        imageTextureCount--;
+    }
+    free(image);
+}
+
+static int loaderMain(void* data) {
+    (void)data;
+    SDL_LockMutex(loaderMutex);
+    while (!loaderStopping) {
+        AsyncImage* image = popImage(&requestHead, &requestTail);
+        if (!image) {
+            SDL_CondWait(requestCondition, loaderMutex);
+            continue;
+        }
+        SDL_Surface* surface = NULL;
+        if (!image->released) {
+            PROFILE_SCOPE("IMG_Load");
+            // Lecture disque et décodage hors verrou
+            SDL_UnlockMutex(loaderMutex);
+            surface = IMG_Load(image->path);
+            if (!surface) printf("Erreur de chargement d'image %s : %s\n", image->path, IMG_GetError());
+            SDL_LockMutex(loaderMutex);
+        }
+        image->surface = surface;
+        image->state = IMAGE_DECODED;
+        pushImage(&decodedHead, &decodedTail, image);
+        SDL_CondBroadcast(decodedCondition);
+    }
+    SDL_UnlockMutex(loaderMutex);
+    return 0;
+}
+
+bool initLoader(SDL_Renderer* renderer) {
+    loaderRenderer = renderer;
+    loaderStopping = false;
+    loaderMutex = SDL_CreateMutex();
+    requestCondition = SDL_CreateCond();
+    decodedCondition = SDL_CreateCond();
+    if (!loaderMutex || !requestCondition || !decodedCondition) {
+        printf("Erreur d'initialisation du chargeur : %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Texture de remplacement : gris neutre semi-transparent
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface) {
+        SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, 128, 128, 128, 96));
+        placeholderTexture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
+        if (placeholderTexture) SDL_SetTextureBlendMode(placeholderTexture, SDL_BLENDMODE_BLEND);
+    }
+
+    // Un cœur reste au thread principal
+    int threadCount = SDL_GetCPUCount() - 1;
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_LOADER_THREADS) threadCount = MAX_LOADER_THREADS;
+    for (int i = 0; i < threadCount; i++) {
+        loaderThreads[loaderThreadCount] = SDL_CreateThread(loaderMain, "loader", NULL);
+        if (!loaderThreads[loaderThreadCount]) {
+            printf("Impossible de creer le thread de chargement : %s\n", SDL_GetError());
+            break;
+        }
+        loaderThreadCount++;
+    }
+    return loaderThreadCount > 0;
+}
+
+void cleanupLoader() {
+    if (!loaderMutex) return;
+    SDL_LockMutex(loaderMutex);
+    loaderStopping = true;
+    SDL_CondBroadcast(requestCondition);
+    SDL_UnlockMutex(loaderMutex);
+    for (int i = 0; i < loaderThreadCount; i++) {
+        SDL_WaitThread(loaderThreads[i], NULL);
+    }
+    loaderThreadCount = 0;
+
+    // Les images encore possédées par le chargeur sont libérées ici
+    AsyncImage* image;
+    while ((image = popImage(&requestHead, &requestTail))) {
+        if (image->released) freeImage(image);
+    }
+    while ((image = popImage(&decodedHead, &decodedTail))) {
+        if (image->released) freeImage(image);
+    }
+    if (placeholderTexture) SDL_DestroyTexture(placeholderTexture);
+    placeholderTexture = NULL;
+    SDL_DestroyCond(requestCondition);
+    SDL_DestroyCond(decodedCondition);
+    SDL_DestroyMutex(loaderMutex);
+    loaderMutex = NULL;
+}
+
+// Renvoie immédiatement ; la texture reste celle de remplacement jusqu'à
+// ce que pumpLoader l'ait créée
+AsyncImage* requestImage(const char* path, bool upload) {
+    AsyncImage* image = calloc(1, sizeof(AsyncImage));
+    if (!image) {
+        printf("Erreur d'allocation memoire pour %s\n", path);
+        return NULL;
+    }
+    snprintf(image->path, sizeof(image->path), "%s", path);
+    image->upload = upload;
+    image->state = IMAGE_QUEUED;
+    image->inLoader = true;
+    const PackEntry* entry = findPackEntry(path, PACK_IMAGE);
+    SDL_LockMutex(loaderMutex);
+    if (entry) {
+        // Déjà décodée dans le paquet : rien à faire pour les threads
+        image->surface = createPackSurface(entry);
+        image->state = IMAGE_DECODED;
+        pushImage(&decodedHead, &decodedTail, image);
+    } else {
+        pushImage(&requestHead, &requestTail, image);
+        SDL_CondSignal(requestCondition);
+    }
+    SDL_UnlockMutex(loaderMutex);
+    return image;
+}
+
+// Une image encore dans les files est libérée par pumpLoader à sa sortie
+void releaseImage(AsyncImage* image) {
+    if (!image) return;
+    SDL_LockMutex(loaderMutex);
+    bool owned = image->inLoader;
+    image->released = true;
+    SDL_UnlockMutex(loaderMutex);
+    if (!owned) freeImage(image);
+}
+
+static void finishImage(AsyncImage* image) {
+    if (image->state != IMAGE_DECODED) return;
+    if (!image->surface) {
+        image->state = IMAGE_FAILED;
+        return;
+    }
+    if (image->upload) {
+        image->texture = SDL_CreateTextureFromSurface(loaderRenderer, image->surface);
+        SDL_FreeSurface(image->surface);
+        image->surface = NULL;
+        if (!image->texture) {
+            printf("Erreur de creation de texture pour %s : %s\n", image->path, SDL_GetError());
+            image->state = IMAGE_FAILED;
+            return;
+        }
+        imageTextureCount++;
+    }
+    image->state = IMAGE_READY;
+}
+
+// À appeler une fois par image affichée : crée les textures décodées tant
+// que le budget le permet (au moins une, pour toujours avancer)
+void pumpLoader() {
+    PROFILE_SCOPE("pumpLoader");
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = (Uint64)(UPLOAD_BUDGET_SECONDS * SDL_GetPerformanceFrequency());
+    for (;;) {
+        SDL_LockMutex(loaderMutex);
+        AsyncImage* image = popImage(&decodedHead, &decodedTail);
+        if (image) image->inLoader = false;
+        SDL_UnlockMutex(loaderMutex);
+        if (!image) return;
+        if (image->released) {
+            freeImage(image);
+            continue;
+        }
+        finishImage(image);
+        if (SDL_GetPerformanceCounter() - start >= budget) return;
+    }
+}
+
+// Bloque jusqu'au décodage puis crée la texture sans attendre pumpLoader
+void waitForImage(AsyncImage* image) {
+    if (!image) return;
+    SDL_LockMutex(loaderMutex);
+    while (image->state == IMAGE_QUEUED) {
+        SDL_CondWait(decodedCondition, loaderMutex);
+    }
+    SDL_UnlockMutex(loaderMutex);
+    finishImage(image);
+}
+
+bool isImageReady(const AsyncImage* image) {
+    return image && image->state == IMAGE_READY;
+}
+
+SDL_Texture* getImageTexture(const AsyncImage* image) {
+    if (image && image->state == IMAGE_READY && image->texture) return image->texture;
+    return placeholderTexture;
+}
+
+int getImageTextureCount() {
+    return imageTextureCount;
+}
+
+// Chargement synchrone, sans cache ni paquet : référence pour `make bench`
+SDL_Texture* loadTexture(const char* path) {
+    SDL_Surface* surface = IMG_Load(path);
+    if (!surface) {
+        printf("Erreur de chargement d'image : %s\n", IMG_GetError());
+        return NULL;
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(loaderRenderer, surface);
+    SDL_FreeSurface(surface);
+    return texture;
+}
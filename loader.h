@@ -0,0 +1,43 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+// Chargement asynchrone des images : décodage sur des threads SDL, envoi
+// des textures par le thread principal dans un budget de temps par image.
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#define MAX_LOADER_THREADS 4
+#define MAX_IMAGE_PATH 128
+#define UPLOAD_BUDGET_SECONDS 0.004 // Temps d'envoi de textures maximal par image affichée
+
+typedef enum {
+    IMAGE_QUEUED,   // En attente ou en cours de décodage
+    IMAGE_DECODED,  // Surface prête, texture pas encore créée
+    IMAGE_READY,
+    IMAGE_FAILED
+} ImageState;
+
+typedef struct AsyncImage {
+    char path[MAX_IMAGE_PATH];
+    ImageState state;
+    bool upload;          // false : seule la surface est demandée (atlas)
+    bool released;        // Abandonnée avant la fin du décodage
+    bool inLoader;        // Encore dans une file du chargeur, libérée par lui
+    SDL_Surface* surface;
+    SDL_Texture* texture;
+    struct AsyncImage* next;
+} AsyncImage;
+
+bool initLoader(SDL_Renderer* renderer);
+void cleanupLoader();
+AsyncImage* requestImage(const char* path, bool upload);
+void releaseImage(AsyncImage* image);
+void pumpLoader();
+void waitForImage(AsyncImage* image);
+bool isImageReady(const AsyncImage* image);
+SDL_Texture* getImageTexture(const AsyncImage* image);
+int getImageTextureCount();
+SDL_Texture* loadTexture(const char* path);
+
+#endif
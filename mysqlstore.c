@@ -0,0 +1,330 @@
+#include "scorestore.h"
+#include <mysql/mysql.h>
+#include <mysql/errmsg.h>
+#include <mysql/mysqld_error.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCORE_DB_HOST "localhost"
+#define SCORE_DB_USER "root"
+#define SCORE_DB_PASSWORD ""
+#define SCORE_DB_NAME "game_db"
+#define SCORE_DB_CONNECT_TIMEOUT 2 // Secondes, pour ne pas figer le menu
+#define SCORE_DB_IO_TIMEOUT 5
+#define MAX_INSERT_ROWS 256     // Par INSERT ; un lot plus grand en enchaîne plusieurs
+
+typedef struct {
+    MYSQL* mysql;
+    MYSQL_STMT* pageStatement;
+    MYSQL_STMT* insertStatements[MAX_INSERT_ROWS + 1]; // Indexé par nombre de lignes
+    unsigned int lastError;
+} MysqlConnection;
+
+// Migration i amène le schéma de la version i à i + 1 ; ne jamais en modifier une publiée.
+// La première reprend la table créée à la main par les anciennes installations.
+static const char* migrations[] = {
+    "CREATE TABLE IF NOT EXISTS Scores ("
+    "    Id INT AUTO_INCREMENT PRIMARY KEY,"
+    "    Nom VARCHAR(50) NOT NULL,"
+    "    Time INT NOT NULL,"
+    "    Difficulte VARCHAR(20) NOT NULL"
+    ") ENGINE = InnoDB",
+    "CREATE INDEX idx_scores_difficulte_time ON Scores (Difficulte, Time DESC, Id DESC)"
+};
+
+static const char* pageQuery =
+    "SELECT Id, Nom, Time, Difficulte FROM Scores"
+    " WHERE Difficulte = ? AND (Time < ? OR (Time = ? AND Id < ?))"
+    " ORDER BY Time DESC, Id DESC LIMIT ?";
+
+static void reportError(MysqlConnection* connection, unsigned int error, const char* message) {
+    connection->lastError = error;
+    printf("Erreur MySQL %u : %s\n", error, message);
+}
+
+static void disconnectMysql(MysqlConnection* connection) {
+    if (connection->pageStatement) mysql_stmt_close(connection->pageStatement);
+    for (int i = 0; i <= MAX_INSERT_ROWS; i++) {
+        if (connection->insertStatements[i]) mysql_stmt_close(connection->insertStatements[i]);
+    }
+    if (connection->mysql) mysql_close(connection->mysql);
+    unsigned int lastError = connection->lastError;
+    memset(connection, 0, sizeof(MysqlConnection));
+    connection->lastError = lastError;
+}
+
+static int readSchemaVersion(MYSQL* mysql) {
+    if (mysql_query(mysql, "SELECT COALESCE(MAX(version), 0) FROM schema_version")) return -1;
+    MYSQL_RES* result = mysql_store_result(mysql);
+    if (!result) return -1;
+    MYSQL_ROW row = mysql_fetch_row(result);
+    int version = row && row[0] ? atoi(row[0]) : -1;
+    mysql_free_result(result);
+    return version;
+}
+
+// GET_LOCK renvoie 1 si le verrou est pris, 0 au bout du délai, NULL en cas d'erreur
+static bool readLockResult(MYSQL* mysql) {
+    MYSQL_RES* result = mysql_store_result(mysql);
+    if (!result) return false;
+    MYSQL_ROW row = mysql_fetch_row(result);
+    bool locked = row && row[0] && strcmp(row[0], "1") == 0;
+    mysql_free_result(result);
+    return locked;
+}
+
+// Une étape peut avoir été appliquée sans que sa version soit enregistrée
+// (DDL non transactionnel, connexion perdue juste après) : l'index déjà
+// présent compte alors comme créé, sinon chaque démarrage échouerait
+static bool runMigration(MYSQL* mysql, const char* statement) {
+    return mysql_query(mysql, statement) == 0 || mysql_errno(mysql) == ER_DUP_KEYNAME;
+}
+
+// Les DDL MySQL ne sont pas transactionnels : un verrou nommé évite que les
+// connexions de lecture et d'écriture, ou deux jeux sur la même base, migrent
+// en même temps. Sans verrou, aucune migration n'est tentée.
+static bool migrate(MysqlConnection* connection) {
+    MYSQL* mysql = connection->mysql;
+    if (mysql_query(mysql, "CREATE TABLE IF NOT EXISTS schema_version (version INT NOT NULL)") ||
+        mysql_query(mysql, "SELECT GET_LOCK('" SCORE_DB_NAME ".schema', 10)")) {
+        reportError(connection, mysql_errno(mysql), mysql_error(mysql));
+        return false;
+    }
+    if (!readLockResult(mysql)) {
+        reportError(connection, ER_LOCK_WAIT_TIMEOUT, "verrou de migration du schema non obtenu");
+        return false;
+    }
+
+    int latest = (int)(sizeof(migrations) / sizeof(migrations[0]));
+    int version = readSchemaVersion(mysql);
+    bool migrated = version >= 0;
+    for (int i = version; migrated && i < latest; i++) {
+        char record[64];
+        snprintf(record, sizeof(record), "INSERT INTO schema_version VALUES (%d)", i + 1);
+        migrated = runMigration(mysql, migrations[i]) && mysql_query(mysql, record) == 0;
+    }
+    if (!migrated) reportError(connection, mysql_errno(mysql), mysql_error(mysql));
+    if (mysql_query(mysql, "SELECT RELEASE_LOCK('" SCORE_DB_NAME ".schema')") == 0) {
+        mysql_free_result(mysql_store_result(mysql));
+    }
+    if (migrated && version < latest) printf("Schema des scores MySQL : version %d -> %d\n", version, latest);
+    return migrated;
+}
+
+static bool connectMysql(MysqlConnection* connection) {
+    connection->mysql = mysql_init(NULL);
+    if (!connection->mysql) {
+        reportError(connection, CR_OUT_OF_MEMORY, "mysql_init() failed");
+        return false;
+    }
+    unsigned int connectTimeout = SCORE_DB_CONNECT_TIMEOUT;
+    unsigned int ioTimeout = SCORE_DB_IO_TIMEOUT;
+    mysql_options(connection->mysql, MYSQL_OPT_CONNECT_TIMEOUT, &connectTimeout);
+    mysql_options(connection->mysql, MYSQL_OPT_READ_TIMEOUT, &ioTimeout);
+    mysql_options(connection->mysql, MYSQL_OPT_WRITE_TIMEOUT, &ioTimeout);
+    if (mysql_real_connect(connection->mysql, SCORE_DB_HOST, SCORE_DB_USER, SCORE_DB_PASSWORD, NULL, 0, NULL, 0) == NULL ||
+        mysql_query(connection->mysql, "CREATE DATABASE IF NOT EXISTS " SCORE_DB_NAME) ||
+        mysql_select_db(connection->mysql, SCORE_DB_NAME)) {
+        reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+        disconnectMysql(connection);
+        return false;
+    }
+    if (!migrate(connection)) {
+        disconnectMysql(connection);
+        return false;
+    }
+    connection->lastError = 0;
+    return true;
+}
+
+// Préparée à la première utilisation, puis réutilisée à chaque requête
+static MYSQL_STMT* getStatement(MysqlConnection* connection, MYSQL_STMT** statement, const char* query) {
+    if (!connection->mysql && !connectMysql(connection)) return NULL;
+    if (*statement) return *statement;
+    MYSQL_STMT* prepared = mysql_stmt_init(connection->mysql);
+    if (!prepared) {
+        reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+        return NULL;
+    }
+    if (mysql_stmt_prepare(prepared, query, strlen(query)) != 0) {
+        reportError(connection, mysql_stmt_errno(prepared), mysql_stmt_error(prepared));
+        mysql_stmt_close(prepared);
+        return NULL;
+    }
+    *statement = prepared;
+    return prepared;
+}
+
+// Le serveur coupe les connexions inactives (wait_timeout) ou a redémarré :
+// les requêtes préparées sont perdues avec la connexion, on repart de zéro
+static bool recoverConnection(MysqlConnection* connection) {
+    if (connection->lastError != CR_SERVER_GONE_ERROR && connection->lastError != CR_SERVER_LOST) return false;
+    printf("Connexion a la base des scores perdue, reconnexion\n");
+    disconnectMysql(connection);
+    return connectMysql(connection);
+}
+
+static void bindString(MYSQL_BIND* bind, const char* text, unsigned long* length) {
+    *length = strlen(text);
+    bind->buffer_type = MYSQL_TYPE_STRING;
+    bind->buffer = (char*)text;
+    bind->buffer_length = *length;
+    bind->length = length;
+}
+
+static void bindInt(MYSQL_BIND* bind, int* value) {
+    bind->buffer_type = MYSQL_TYPE_LONG;
+    bind->buffer = value;
+}
+
+// Un seul INSERT pour tout le lot : une seule transaction et un seul aller-retour
+static bool executeInsert(MysqlConnection* connection, const Score* scores, int count) {
+    char query[64 + MAX_INSERT_ROWS * 12];
+    int length = snprintf(query, sizeof(query), "INSERT INTO Scores (Nom, Time, Difficulte) VALUES ");
+    for (int i = 0; i < count; i++) {
+        length += snprintf(query + length, sizeof(query) - length, i == 0 ? "(?, ?, ?)" : ", (?, ?, ?)");
+    }
+    MYSQL_STMT* statement = getStatement(connection, &connection->insertStatements[count], query);
+    if (!statement) return false;
+
+    MYSQL_BIND params[MAX_INSERT_ROWS * 3];
+    unsigned long lengths[MAX_INSERT_ROWS * 2];
+    int times[MAX_INSERT_ROWS];
+    memset(params, 0, sizeof(params));
+    for (int i = 0; i < count; i++) {
+        times[i] = scores[i].time;
+        bindString(&params[i * 3], scores[i].nom, &lengths[i * 2]);
+        bindInt(&params[i * 3 + 1], &times[i]);
+        bindString(&params[i * 3 + 2], scores[i].difficulte, &lengths[i * 2 + 1]);
+    }
+    if (mysql_stmt_bind_param(statement, params) || mysql_stmt_execute(statement)) {
+        reportError(connection, mysql_stmt_errno(statement), mysql_stmt_error(statement));
+        return false;
+    }
+    return true;
+}
+
+static int executePage(MysqlConnection* connection, const char* difficulte, ScoreCursor after, Score* scores, int count) {
+    MYSQL_STMT* statement = getStatement(connection, &connection->pageStatement, pageQuery);
+    if (!statement) return -1;
+
+    MYSQL_BIND params[5];
+    unsigned long difficultyLength;
+    memset(params, 0, sizeof(params));
+    bindString(&params[0], difficulte, &difficultyLength);
+    bindInt(&params[1], &after.time);
+    bindInt(&params[2], &after.time);
+    bindInt(&params[3], &after.id);
+    bindInt(&params[4], &count);
+
+    // Chaque ligne est lue dans row puis recopiée ; les noms trop longs sont tronqués
+    Score row;
+    MYSQL_BIND columns[4];
+    unsigned long nameLength = 0, rowDifficultyLength = 0;
+    memset(columns, 0, sizeof(columns));
+    bindInt(&columns[0], &row.id);
+    columns[1].buffer_type = MYSQL_TYPE_STRING;
+    columns[1].buffer = row.nom;
+    columns[1].buffer_length = sizeof(row.nom) - 1;
+    columns[1].length = &nameLength;
+    bindInt(&columns[2], &row.time);
+    columns[3].buffer_type = MYSQL_TYPE_STRING;
+    columns[3].buffer = row.difficulte;
+    columns[3].buffer_length = sizeof(row.difficulte) - 1;
+    columns[3].length = &rowDifficultyLength;
+
+    if (mysql_stmt_bind_param(statement, params) || mysql_stmt_execute(statement) ||
+        mysql_stmt_bind_result(statement, columns)) {
+        reportError(connection, mysql_stmt_errno(statement), mysql_stmt_error(statement));
+        return -1;
+    }
+    int found = 0;
+    int status;
+    while (found < count && ((status = mysql_stmt_fetch(statement)) == 0 || status == MYSQL_DATA_TRUNCATED)) {
+        row.nom[nameLength < sizeof(row.nom) - 1 ? nameLength : sizeof(row.nom) - 1] = '\0';
+        row.difficulte[rowDifficultyLength < sizeof(row.difficulte) - 1 ? rowDifficultyLength : sizeof(row.difficulte) - 1] = '\0';
+        scores[found++] = row;
+    }
+    mysql_stmt_free_result(statement);
+    return found;
+}
+
+static void* openMysql() {
+    mysql_library_init(0, NULL, NULL); // Sans effet après le premier appel
+    MysqlConnection* connection = calloc(1, sizeof(MysqlConnection));
+    if (connection && !connectMysql(connection)) {
+        free(connection);
+        connection = NULL;
+    }
+    return connection;
+}
+
+static void closeMysql(void* connection) {
+    if (!connection) return;
+    disconnectMysql(connection);
+    free(connection);
+}
+
+static bool insertMysql(void* opened, const Score* scores, int count) {
+    MysqlConnection* connection = opened;
+    if (count <= MAX_INSERT_ROWS) {
+        // Une seule requête : atomique sans transaction explicite
+        bool inserted = executeInsert(connection, scores, count);
+        if (!inserted && recoverConnection(connection)) inserted = executeInsert(connection, scores, count);
+        return inserted;
+    }
+    // Plusieurs INSERT dans une transaction : tout le lot ou rien
+    if (!connection->mysql && !connectMysql(connection)) return false;
+    if (mysql_query(connection->mysql, "START TRANSACTION")) {
+        reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+        return false;
+    }
+    for (int begin = 0; begin < count; begin += MAX_INSERT_ROWS) {
+        int rows = count - begin < MAX_INSERT_ROWS ? count - begin : MAX_INSERT_ROWS;
+        if (!executeInsert(connection, scores + begin, rows)) {
+            mysql_query(connection->mysql, "ROLLBACK");
+            return false;
+        }
+    }
+    if (mysql_commit(connection->mysql)) {
+        reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+        return false;
+    }
+    return true;
+}
+
+// Parcours de l'index (Difficulte, Time) seul, lu en flux sans tout stocker
+static bool histogramMysql(void* opened, void (*row)(const char* difficulte, int time, int count)) {
+    MysqlConnection* connection = opened;
+    if (!connection->mysql && !connectMysql(connection)) return false;
+    if (mysql_query(connection->mysql, "SELECT Difficulte, Time, COUNT(*) FROM Scores GROUP BY Difficulte, Time")) {
+        reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+        return false;
+    }
+    MYSQL_RES* result = mysql_use_result(connection->mysql);
+    if (!result) {
+        reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+        return false;
+    }
+    MYSQL_ROW values;
+    while ((values = mysql_fetch_row(result))) {
+        if (values[0] && values[1] && values[2]) row(values[0], atoi(values[1]), atoi(values[2]));
+    }
+    bool complete = mysql_errno(connection->mysql) == 0;
+    if (!complete) reportError(connection, mysql_errno(connection->mysql), mysql_error(connection->mysql));
+    mysql_free_result(result);
+    return complete;
+}
+
+static int pageMysql(void* connection, const char* difficulte, ScoreCursor after, Score* scores, int count) {
+    int found = executePage(connection, difficulte, after, scores, count);
+    if (found < 0 && recoverConnection(connection)) found = executePage(connection, difficulte, after, scores, count);
+    return found;
+}
+
+static void threadEndMysql() {
+    mysql_thread_end();
+}
+
+const ScoreStore mysqlScoreStore = {"MySQL", openMysql, closeMysql, insertMysql, pageMysql, histogramMysql, threadEndMysql};
@@ -0,0 +1,102 @@
+#include "pack.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint8_t* packData = NULL;
+static size_t packSize = 0;
+static const PackEntry* packEntries = NULL;
+static uint32_t packEntryCount = 0;
+
+bool openPack(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false; // Pas de paquet : fichiers d'origine
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(PackHeader)) {
+        close(fd);
+        return false;
+    }
+    void* mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // La projection reste valide
+    if (mapping == MAP_FAILED) {
+        printf("Impossible de projeter %s en memoire\n", path);
+        return false;
+    }
+
+    const PackHeader* header = mapping;
+    size_t indexEnd = sizeof(PackHeader) + (size_t)header->entryCount * sizeof(PackEntry);
+    if (header->magic != PACK_MAGIC || header->version != PACK_VERSION || indexEnd > (size_t)info.st_size) {
+        printf("Paquet de ressources invalide ou obsolete : %s\n", path);
+        munmap(mapping, info.st_size);
+        return false;
+    }
+    const PackEntry* entries = (const PackEntry*)(header + 1);
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        if (entries[i].offset + entries[i].size > (uint64_t)info.st_size) {
+            printf("Paquet de ressources tronque : %s\n", path);
+            munmap(mapping, info.st_size);
+            return false;
+        }
+    }
+
+    packData = mapping;
+    packSize = info.st_size;
+    packEntries = entries;
+    packEntryCount = header->entryCount;
+    return true;
+}
+
+// Les sons et polices créés depuis le paquet doivent être libérés avant
+void closePack() {
+    if (packData) munmap((void*)packData, packSize);
+    packData = NULL;
+    packSize = 0;
+    packEntries = NULL;
+    packEntryCount = 0;
+}
+
+bool isPackOpen() {
+    return packData != NULL;
+}
+
+const PackEntry* findPackEntry(const char* path, PackKind kind) {
+    for (uint32_t i = 0; i < packEntryCount; i++) {
+        if (packEntries[i].kind == (uint32_t)kind && strncmp(packEntries[i].path, path, MAX_PACK_PATH) == 0) {
+            return &packEntries[i];
+        }
+    }
+    return NULL;
+}
+
+const void* getPackData(const PackEntry* entry) {
+    return packData + entry->offset;
+}
+
+// Surface qui pointe directement dans les pages projetées, sans copie
+SDL_Surface* createPackSurface(const PackEntry* entry) {
+    return SDL_CreateRGBSurfaceWithFormatFrom((void*)getPackData(entry), entry->width, entry->height,
+                                              32, entry->width * 4, SDL_PIXELFORMAT_RGBA32);
+}
+
+Mix_Chunk* loadPackChunk(const PackEntry* entry) {
+    const Uint8* wav = getPackData(entry);
+    int frequency, channels;
+    Uint16 format;
+    if (Mix_QuerySpec(&frequency, &format, &channels) && frequency == PACK_AUDIO_FREQUENCY &&
+        format == PACK_AUDIO_FORMAT && channels == PACK_AUDIO_CHANNELS) {
+        // Même format que le mixeur : le PCM est joué depuis la projection
+        return Mix_QuickLoad_RAW((Uint8*)wav + WAV_HEADER_SIZE, (Uint32)(entry->size - WAV_HEADER_SIZE));
+    }
+    return Mix_LoadWAV_RW(SDL_RWFromConstMem(wav, (int)entry->size), 1);
+}
+
+Mix_Music* loadPackMusic(const PackEntry* entry) {
+    return Mix_LoadMUS_RW(SDL_RWFromConstMem(getPackData(entry), (int)entry->size), 1);
+}
+
+TTF_Font* loadPackFont(const PackEntry* entry, int size) {
+    return TTF_OpenFontRW(SDL_RWFromConstMem(getPackData(entry), (int)entry->size), 1, size);
+}
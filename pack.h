@@ -0,0 +1,61 @@
+#ifndef PACK_H
+#define PACK_H
+
+// Fichier de ressources pré-décodées produit par `make pack` : images en
+// RGBA déjà à leur taille d'affichage, sons en PCM au format du mixeur.
+// Projeté en mémoire au démarrage ; sans lui, le jeu lit les fichiers d'origine.
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PACK_PATH "valo.pack"
+#define PACK_MAGIC 0x4B504C56 // "VLPK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 4096   // Chaque bloc commence sur une page
+#define MAX_PACK_PATH 64
+
+// Format audio commun au paquet et à Mix_OpenAudio
+#define PACK_AUDIO_FREQUENCY 44100
+#define PACK_AUDIO_FORMAT AUDIO_S16LSB
+#define PACK_AUDIO_CHANNELS 2
+#define WAV_HEADER_SIZE 44
+
+typedef enum {
+    PACK_IMAGE,  // Pixels RGBA32, lignes contiguës (pitch = width * 4)
+    PACK_SOUND,  // Fichier WAV : en-tête de 44 octets puis PCM
+    PACK_MUSIC,  // Idem, lu en flux par Mix_LoadMUS_RW
+    PACK_FONT    // Fichier TTF tel quel
+} PackKind;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+} PackHeader;
+
+// Index placé juste après l'en-tête
+typedef struct {
+    char path[MAX_PACK_PATH]; // Chemin d'origine, clé de recherche
+    uint32_t kind;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    uint64_t offset;          // Depuis le début du fichier
+    uint64_t size;
+} PackEntry;
+
+bool openPack(const char* path);
+void closePack();
+bool isPackOpen();
+const PackEntry* findPackEntry(const char* path, PackKind kind);
+const void* getPackData(const PackEntry* entry);
+SDL_Surface* createPackSurface(const PackEntry* entry);
+Mix_Chunk* loadPackChunk(const PackEntry* entry);
+Mix_Music* loadPackMusic(const PackEntry* entry);
+TTF_Font* loadPackFont(const PackEntry* entry, int size);
+
+#endif
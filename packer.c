@@ -0,0 +1,218 @@
+// Outil hors ligne : convertit les images, sons et polices du jeu en un
+// seul fichier de paquet (voir pack.h). Utilisation :
+//   ./valopack sortie.pack fichier1 fichier2 ...
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pack.h"
+#include "physics.h"
+
+// Taille d'affichage des images ; les autres gardent leur taille d'origine
+typedef struct {
+    const char* prefix;
+    int width, height;
+} ImageSize;
+
+static const ImageSize imageSizes[] = {
+    {"background.png", WORLD_WIDTH, WORLD_HEIGHT},       // Plein écran
+    {"menu_background.png", WORLD_WIDTH, WORLD_HEIGHT},
+    {"Smoke.png", BALL_RADIUS * 2, BALL_RADIUS * 2},     // Une balle
+    {"assets/arrow_keys.png", 240, 240},                 // Tutoriel : 200 px agrandis jusqu'à x1.2
+    {"user/", 96, 96}                                     // Portraits : cases de 80 px agrandies jusqu'à x1.2
+};
+
+typedef struct {
+    PackEntry entry;
+    void* data;
+} PackItem;
+
+static bool endsWith(const char* text, const char* suffix) {
+    size_t length = strlen(text), suffixLength = strlen(suffix);
+    return length >= suffixLength && strcmp(text + length - suffixLength, suffix) == 0;
+}
+
+static void* readFile(const char* path, uint64_t* size) {
+    SDL_RWops* file = SDL_RWFromFile(path, "rb");
+    if (!file) return NULL;
+    Sint64 length = SDL_RWsize(file);
+    void* data = length > 0 ? malloc(length) : NULL;
+    if (data && SDL_RWread(file, data, 1, length) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    SDL_RWclose(file);
+    *size = data ? (uint64_t)length : 0;
+    return data;
+}
+
+static bool packImage(const char* path, PackItem* item) {
+    SDL_Surface* loaded = IMG_Load(path);
+    if (!loaded) {
+        printf("%s : %s\n", path, IMG_GetError());
+        return false;
+    }
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!rgba) return false;
+
+    int width = rgba->w, height = rgba->h;
+    for (size_t i = 0; i < SDL_arraysize(imageSizes); i++) {
+        if (strncmp(path, imageSizes[i].prefix, strlen(imageSizes[i].prefix)) == 0) {
+            width = imageSizes[i].width;
+            height = imageSizes[i].height;
+            break;
+        }
+    }
+    // Surface de sortie à lignes contiguës, mise à l'échelle bilinéaire si besoin
+    SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!scaled) {
+        SDL_FreeSurface(rgba);
+        return false;
+    }
+    if (width == rgba->w && height == rgba->h) {
+        SDL_SetSurfaceBlendMode(rgba, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(rgba, NULL, scaled, NULL);
+    } else {
+        SDL_SoftStretchLinear(rgba, NULL, scaled, NULL);
+    }
+    SDL_FreeSurface(rgba);
+
+    item->entry.kind = PACK_IMAGE;
+    item->entry.width = width;
+    item->entry.height = height;
+    item->entry.size = (uint64_t)width * height * 4;
+    item->data = malloc(item->entry.size);
+    if (item->data) {
+        for (int y = 0; y < height; y++) {
+            memcpy((Uint8*)item->data + (size_t)y * width * 4, (Uint8*)scaled->pixels + (size_t)y * scaled->pitch, width * 4);
+        }
+    }
+    SDL_FreeSurface(scaled);
+    return item->data != NULL;
+}
+
+static void writeLittle32(Uint8* out, Uint32 value) {
+    out[0] = value & 0xFF;
+    out[1] = (value >> 8) & 0xFF;
+    out[2] = (value >> 16) & 0xFF;
+    out[3] = (value >> 24) & 0xFF;
+}
+
+// Décodé par SDL_mixer (WAV comme MP3) au format du mixeur, puis stocké en WAV
+static bool packAudio(const char* path, PackKind kind, PackItem* item) {
+    Mix_Chunk* chunk = Mix_LoadWAV(path);
+    if (!chunk) {
+        printf("%s : %s\n", path, Mix_GetError());
+        return false;
+    }
+    Uint32 blockAlign = PACK_AUDIO_CHANNELS * 2;
+    item->entry.kind = kind;
+    item->entry.size = WAV_HEADER_SIZE + (uint64_t)chunk->alen;
+    item->data = malloc(item->entry.size);
+    if (item->data) {
+        Uint8* wav = item->data;
+        memcpy(wav, "RIFF", 4);
+        writeLittle32(wav + 4, 36 + chunk->alen);
+        memcpy(wav + 8, "WAVEfmt ", 8);
+        writeLittle32(wav + 16, 16);
+        writeLittle32(wav + 20, 1 | (PACK_AUDIO_CHANNELS << 16)); // PCM, canaux
+        writeLittle32(wav + 24, PACK_AUDIO_FREQUENCY);
+        writeLittle32(wav + 28, PACK_AUDIO_FREQUENCY * blockAlign);
+        writeLittle32(wav + 32, blockAlign | (16 << 16));          // Alignement, bits
+        memcpy(wav + 36, "data", 4);
+        writeLittle32(wav + 40, chunk->alen);
+        memcpy(wav + WAV_HEADER_SIZE, chunk->abuf, chunk->alen);
+    }
+    Mix_FreeChunk(chunk);
+    return item->data != NULL;
+}
+
+static bool packFile(const char* path, PackItem* item) {
+    memset(item, 0, sizeof(PackItem));
+    if (strlen(path) >= MAX_PACK_PATH) {
+        printf("Chemin trop long : %s\n", path);
+        return false;
+    }
+    strcpy(item->entry.path, path);
+    if (endsWith(path, ".png") || endsWith(path, ".jpg")) return packImage(path, item);
+    if (endsWith(path, ".wav")) return packAudio(path, PACK_SOUND, item);
+    if (endsWith(path, ".mp3")) return packAudio(path, PACK_MUSIC, item);
+    if (endsWith(path, ".ttf")) {
+        item->entry.kind = PACK_FONT;
+        item->data = readFile(path, &item->entry.size);
+        return item->data != NULL;
+    }
+    printf("Type de fichier inconnu : %s\n", path);
+    return false;
+}
+
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + PACK_ALIGNMENT - 1) & ~(uint64_t)(PACK_ALIGNMENT - 1);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Utilisation : %s sortie.pack fichiers...\n", argv[0]);
+        return 1;
+    }
+    // Pas de fenêtre ni de son réel : seul le décodage est utilisé
+    if (SDL_Init(SDL_INIT_AUDIO) < 0 || IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) == 0 ||
+        Mix_OpenAudio(PACK_AUDIO_FREQUENCY, PACK_AUDIO_FORMAT, PACK_AUDIO_CHANNELS, 2048) < 0) {
+        printf("Erreur d'initialisation: %s\n", SDL_GetError());
+        return 1;
+    }
+    int frequency, channels;
+    Uint16 format;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    if (frequency != PACK_AUDIO_FREQUENCY || format != PACK_AUDIO_FORMAT || channels != PACK_AUDIO_CHANNELS) {
+        printf("Format audio obtenu different du format du paquet\n");
+        return 1;
+    }
+
+    int count = argc - 2;
+    PackItem* items = calloc(count, sizeof(PackItem));
+    if (!items) return 1;
+    for (int i = 0; i < count; i++) {
+        if (!packFile(argv[i + 2], &items[i])) {
+            printf("Echec de conversion : %s\n", argv[i + 2]);
+            return 1;
+        }
+    }
+
+    // En-tête, index, puis les blocs de données alignés sur une page
+    PackHeader header = {PACK_MAGIC, PACK_VERSION, (uint32_t)count, 0};
+    uint64_t offset = alignOffset(sizeof(PackHeader) + (uint64_t)count * sizeof(PackEntry));
+    for (int i = 0; i < count; i++) {
+        items[i].entry.offset = offset;
+        offset = alignOffset(offset + items[i].entry.size);
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (!out) {
+        printf("Impossible d'ecrire %s\n", argv[1]);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+    for (int i = 0; i < count; i++) {
+        fwrite(&items[i].entry, sizeof(PackEntry), 1, out);
+    }
+    for (int i = 0; i < count; i++) {
+        fseek(out, (long)items[i].entry.offset, SEEK_SET);
+        fwrite(items[i].data, 1, items[i].entry.size, out);
+        free(items[i].data);
+    }
+    // Le dernier bloc est complété jusqu'à la fin de sa page
+    fseek(out, (long)offset - 1, SEEK_SET);
+    fputc(0, out);
+    fclose(out);
+    printf("%s : %d fichiers, %llu octets\n", argv[1], count, (unsigned long long)offset);
+
+    free(items);
+    Mix_CloseAudio();
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,285 @@
+#include "physics.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define PHYSICS_X86 1
+#include <immintrin.h>
+#endif
+
+#define BALL_ARRAY_COUNT 6
+#define BALL_ALIGNMENT 32
+
+static PhysicsBackend physicsBackend = PHYSICS_SCALAR;
+static bool physicsBackendChosen = false;
+
+bool allocBalls(BallArrays* balls, int count) {
+    memset(balls, 0, sizeof(BallArrays));
+    // Chaque tableau commence sur une frontière de 32 octets (un registre AVX)
+    size_t stride = ((size_t)(count > 0 ? count : 1) + 7) & ~(size_t)7;
+    float* block = aligned_alloc(BALL_ALIGNMENT, stride * BALL_ARRAY_COUNT * sizeof(float));
+    if (!block) {
+        printf("Erreur d'allocation memoire pour les balles\n");
+        return false;
+    }
+    memset(block, 0, stride * BALL_ARRAY_COUNT * sizeof(float));
+    balls->x = block;
+    balls->y = block + stride;
+    balls->dx = block + stride * 2;
+    balls->dy = block + stride * 3;
+    balls->prevX = block + stride * 4;
+    balls->prevY = block + stride * 5;
+    balls->count = count;
+    return true;
+}
+
+void freeBalls(BallArrays* balls) {
+    free(balls->x); // Un seul bloc pour tous les tableaux
+    memset(balls, 0, sizeof(BallArrays));
+}
+
+PhysicsBackend detectPhysicsBackend() {
+#ifdef PHYSICS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return PHYSICS_AVX2;
+    return PHYSICS_SSE2;
+#else
+    return PHYSICS_SCALAR;
+#endif
+}
+
+void setPhysicsBackend(PhysicsBackend backend) {
+    PhysicsBackend best = detectPhysicsBackend();
+    physicsBackend = backend > best ? best : backend;
+    physicsBackendChosen = true;
+}
+
+PhysicsBackend getPhysicsBackend() {
+    if (!physicsBackendChosen) setPhysicsBackend(detectPhysicsBackend());
+    return physicsBackend;
+}
+
+const char* getPhysicsBackendName() {
+    switch (getPhysicsBackend()) {
+        case PHYSICS_AVX2: return "avx2";
+        case PHYSICS_SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+// Référence scalaire : mêmes règles que l'ancien checkCollision(SDL_Rect, Ball)
+bool checkCollision(SimRect a, float ballX, float ballY) {
+    float closestX = (a.x < ballX) ? (float)(a.x + a.w) : (float)a.x;
+    float closestY = (a.y < ballY) ? (float)(a.y + a.h) : (float)a.y;
+    float distanceX = ballX - closestX;
+    float distanceY = ballY - closestY;
+    return (distanceX * distanceX + distanceY * distanceY) <= (float)(BALL_RADIUS * BALL_RADIUS);
+}
+
+// contain : règle du mode chocs entre balles (voir physics.h)
+static void moveBallRangeScalar(BallArrays* balls, int begin, int end, bool contain) {
+    for (int i = begin; i < end; i++) {
+        balls->prevX[i] = balls->x[i];
+        balls->prevY[i] = balls->y[i];
+        balls->x[i] += balls->dx[i];
+        balls->y[i] += balls->dy[i];
+        if (!contain) {
+            if (balls->x[i] - BALL_RADIUS <= 0 || balls->x[i] + BALL_RADIUS >= WORLD_WIDTH)
+                balls->dx[i] = -balls->dx[i];
+            if (balls->y[i] - BALL_RADIUS <= 0 || balls->y[i] + BALL_RADIUS >= WORLD_HEIGHT)
+                balls->dy[i] = -balls->dy[i];
+            continue;
+        }
+        // Un choc entre balles peut repousser une balle vers le mur : un simple
+        // changement de signe la ferait alors osciller hors du monde
+        if (balls->x[i] - BALL_RADIUS <= 0) {
+            balls->x[i] = BALL_RADIUS;
+            balls->dx[i] = fabsf(balls->dx[i]);
+        } else if (balls->x[i] + BALL_RADIUS >= WORLD_WIDTH) {
+            balls->x[i] = WORLD_WIDTH - BALL_RADIUS;
+            balls->dx[i] = -fabsf(balls->dx[i]);
+        }
+        if (balls->y[i] - BALL_RADIUS <= 0) {
+            balls->y[i] = BALL_RADIUS;
+            balls->dy[i] = fabsf(balls->dy[i]);
+        } else if (balls->y[i] + BALL_RADIUS >= WORLD_HEIGHT) {
+            balls->y[i] = WORLD_HEIGHT - BALL_RADIUS;
+            balls->dy[i] = -fabsf(balls->dy[i]);
+        }
+    }
+}
+
+static int findCollisionScalar(const BallArrays* balls, SimRect player, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        if (checkCollision(player, balls->x[i], balls->y[i])) return i;
+    }
+    return -1;
+}
+
+#ifdef PHYSICS_X86
+// Les noyaux vectoriels effectuent exactement les mêmes opérations que la
+// version scalaire (pas de FMA), les résultats sont donc identiques bit à bit
+static void moveBallRangeSse2(BallArrays* balls, int begin, int end, bool contain) {
+    const __m128 radius = _mm_set1_ps(BALL_RADIUS);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 width = _mm_set1_ps(WORLD_WIDTH);
+    const __m128 height = _mm_set1_ps(WORLD_HEIGHT);
+    const __m128 maxX = _mm_set1_ps(WORLD_WIDTH - BALL_RADIUS);
+    const __m128 maxY = _mm_set1_ps(WORLD_HEIGHT - BALL_RADIUS);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(balls->x + i);
+        __m128 y = _mm_loadu_ps(balls->y + i);
+        __m128 dx = _mm_loadu_ps(balls->dx + i);
+        __m128 dy = _mm_loadu_ps(balls->dy + i);
+        _mm_storeu_ps(balls->prevX + i, x);
+        _mm_storeu_ps(balls->prevY + i, y);
+        x = _mm_add_ps(x, dx);
+        y = _mm_add_ps(y, dy);
+        __m128 left = _mm_cmple_ps(_mm_sub_ps(x, radius), zero);
+        __m128 right = _mm_cmpge_ps(_mm_add_ps(x, radius), width);
+        __m128 top = _mm_cmple_ps(_mm_sub_ps(y, radius), zero);
+        __m128 bottom = _mm_cmpge_ps(_mm_add_ps(y, radius), height);
+        if (contain) {
+            // Bit de signe effacé au mur gauche (haut), forcé au mur droit (bas),
+            // position bornée : mêmes choix que la version scalaire
+            right = _mm_andnot_ps(left, right);
+            bottom = _mm_andnot_ps(top, bottom);
+            x = _mm_or_ps(_mm_andnot_ps(_mm_or_ps(left, right), x),
+                          _mm_or_ps(_mm_and_ps(left, radius), _mm_and_ps(right, maxX)));
+            y = _mm_or_ps(_mm_andnot_ps(_mm_or_ps(top, bottom), y),
+                          _mm_or_ps(_mm_and_ps(top, radius), _mm_and_ps(bottom, maxY)));
+            dx = _mm_or_ps(_mm_andnot_ps(_mm_and_ps(left, sign), dx), _mm_and_ps(right, sign));
+            dy = _mm_or_ps(_mm_andnot_ps(_mm_and_ps(top, sign), dy), _mm_and_ps(bottom, sign));
+        } else {
+            dx = _mm_xor_ps(dx, _mm_and_ps(_mm_or_ps(left, right), sign));
+            dy = _mm_xor_ps(dy, _mm_and_ps(_mm_or_ps(top, bottom), sign));
+        }
+        _mm_storeu_ps(balls->x + i, x);
+        _mm_storeu_ps(balls->y + i, y);
+        _mm_storeu_ps(balls->dx + i, dx);
+        _mm_storeu_ps(balls->dy + i, dy);
+    }
+    moveBallRangeScalar(balls, i, end, contain);
+}
+
+static int findCollisionSse2(const BallArrays* balls, SimRect player, int begin, int end) {
+    const __m128 left = _mm_set1_ps((float)player.x);
+    const __m128 right = _mm_set1_ps((float)(player.x + player.w));
+    const __m128 top = _mm_set1_ps((float)player.y);
+    const __m128 bottom = _mm_set1_ps((float)(player.y + player.h));
+    const __m128 radiusSquared = _mm_set1_ps((float)(BALL_RADIUS * BALL_RADIUS));
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(balls->x + i);
+        __m128 y = _mm_loadu_ps(balls->y + i);
+        __m128 pickRight = _mm_cmplt_ps(left, x);
+        __m128 pickBottom = _mm_cmplt_ps(top, y);
+        __m128 closestX = _mm_or_ps(_mm_and_ps(pickRight, right), _mm_andnot_ps(pickRight, left));
+        __m128 closestY = _mm_or_ps(_mm_and_ps(pickBottom, bottom), _mm_andnot_ps(pickBottom, top));
+        __m128 distanceX = _mm_sub_ps(x, closestX);
+        __m128 distanceY = _mm_sub_ps(y, closestY);
+        __m128 distance = _mm_add_ps(_mm_mul_ps(distanceX, distanceX), _mm_mul_ps(distanceY, distanceY));
+        int hits = _mm_movemask_ps(_mm_cmple_ps(distance, radiusSquared));
+        if (hits) return i + __builtin_ctz(hits);
+    }
+    return findCollisionScalar(balls, player, i, end);
+}
+
+__attribute__((target("avx2")))
+static void moveBallRangeAvx2(BallArrays* balls, int begin, int end, bool contain) {
+    const __m256 radius = _mm256_set1_ps(BALL_RADIUS);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 width = _mm256_set1_ps(WORLD_WIDTH);
+    const __m256 height = _mm256_set1_ps(WORLD_HEIGHT);
+    const __m256 maxX = _mm256_set1_ps(WORLD_WIDTH - BALL_RADIUS);
+    const __m256 maxY = _mm256_set1_ps(WORLD_HEIGHT - BALL_RADIUS);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(balls->x + i);
+        __m256 y = _mm256_loadu_ps(balls->y + i);
+        __m256 dx = _mm256_loadu_ps(balls->dx + i);
+        __m256 dy = _mm256_loadu_ps(balls->dy + i);
+        _mm256_storeu_ps(balls->prevX + i, x);
+        _mm256_storeu_ps(balls->prevY + i, y);
+        x = _mm256_add_ps(x, dx);
+        y = _mm256_add_ps(y, dy);
+        __m256 left = _mm256_cmp_ps(_mm256_sub_ps(x, radius), zero, _CMP_LE_OQ);
+        __m256 right = _mm256_cmp_ps(_mm256_add_ps(x, radius), width, _CMP_GE_OQ);
+        __m256 top = _mm256_cmp_ps(_mm256_sub_ps(y, radius), zero, _CMP_LE_OQ);
+        __m256 bottom = _mm256_cmp_ps(_mm256_add_ps(y, radius), height, _CMP_GE_OQ);
+        if (contain) {
+            right = _mm256_andnot_ps(left, right);
+            bottom = _mm256_andnot_ps(top, bottom);
+            x = _mm256_blendv_ps(_mm256_blendv_ps(x, radius, left), maxX, right);
+            y = _mm256_blendv_ps(_mm256_blendv_ps(y, radius, top), maxY, bottom);
+            dx = _mm256_or_ps(_mm256_andnot_ps(_mm256_and_ps(left, sign), dx), _mm256_and_ps(right, sign));
+            dy = _mm256_or_ps(_mm256_andnot_ps(_mm256_and_ps(top, sign), dy), _mm256_and_ps(bottom, sign));
+        } else {
+            dx = _mm256_xor_ps(dx, _mm256_and_ps(_mm256_or_ps(left, right), sign));
+            dy = _mm256_xor_ps(dy, _mm256_and_ps(_mm256_or_ps(top, bottom), sign));
+        }
+        _mm256_storeu_ps(balls->x + i, x);
+        _mm256_storeu_ps(balls->y + i, y);
+        _mm256_storeu_ps(balls->dx + i, dx);
+        _mm256_storeu_ps(balls->dy + i, dy);
+    }
+    moveBallRangeSse2(balls, i, end, contain);
+}
+
+__attribute__((target("avx2")))
+static int findCollisionAvx2(const BallArrays* balls, SimRect player, int begin, int end) {
+    const __m256 left = _mm256_set1_ps((float)player.x);
+    const __m256 right = _mm256_set1_ps((float)(player.x + player.w));
+    const __m256 top = _mm256_set1_ps((float)player.y);
+    const __m256 bottom = _mm256_set1_ps((float)(player.y + player.h));
+    const __m256 radiusSquared = _mm256_set1_ps((float)(BALL_RADIUS * BALL_RADIUS));
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(balls->x + i);
+        __m256 y = _mm256_loadu_ps(balls->y + i);
+        __m256 closestX = _mm256_blendv_ps(left, right, _mm256_cmp_ps(left, x, _CMP_LT_OQ));
+        __m256 closestY = _mm256_blendv_ps(top, bottom, _mm256_cmp_ps(top, y, _CMP_LT_OQ));
+        __m256 distanceX = _mm256_sub_ps(x, closestX);
+        __m256 distanceY = _mm256_sub_ps(y, closestY);
+        __m256 distance = _mm256_add_ps(_mm256_mul_ps(distanceX, distanceX), _mm256_mul_ps(distanceY, distanceY));
+        int hits = _mm256_movemask_ps(_mm256_cmp_ps(distance, radiusSquared, _CMP_LE_OQ));
+        if (hits) return i + __builtin_ctz(hits);
+    }
+    return findCollisionSse2(balls, player, i, end);
+}
+#endif
+
+void moveBallRange(BallArrays* balls, int begin, int end, bool contain) {
+    switch (getPhysicsBackend()) {
+#ifdef PHYSICS_X86
+        case PHYSICS_AVX2:
+            moveBallRangeAvx2(balls, begin, end, contain);
+            break;
+        case PHYSICS_SSE2:
+            moveBallRangeSse2(balls, begin, end, contain);
+            break;
+#endif
+        default:
+            moveBallRangeScalar(balls, begin, end, contain);
+            break;
+    }
+}
+
+// Renvoie l'indice de la première balle touchant le joueur, -1 sinon
+int findCollisionInRange(const BallArrays* balls, SimRect player, int begin, int end) {
+    switch (getPhysicsBackend()) {
+#ifdef PHYSICS_X86
+        case PHYSICS_AVX2:
+            return findCollisionAvx2(balls, player, begin, end);
+        case PHYSICS_SSE2:
+            return findCollisionSse2(balls, player, begin, end);
+#endif
+        default:
+            return findCollisionScalar(balls, player, begin, end);
+    }
+}
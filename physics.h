@@ -0,0 +1,50 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+// Stockage des balles en structure de tableaux et noyaux vectorisés
+// (AVX2, SSE2 ou scalaire selon le processeur).
+
+#include <stdbool.h>
+
+#define WORLD_WIDTH 800
+#define WORLD_HEIGHT 600
+#define BALL_RADIUS 20
+
+typedef struct {
+    int x, y, w, h;
+} SimRect;
+
+// Une entrée par balle dans chaque tableau. Les positions restent des
+// entiers exacts en mode normal : les règles sont celles de l'ancien
+// tableau de Ball {int x, y, dx, dy}, la vitesse change de signe au contact
+// d'un mur et la balle peut le dépasser de moins d'un pas.
+// Avec les chocs entre balles (moveBallRange avec contain), une balle au mur
+// est ramenée à BALL_RADIUS du bord et repart vers l'intérieur quel que soit
+// le signe de sa vitesse : un choc peut la renvoyer vers le mur.
+typedef struct {
+    float* x;
+    float* y;
+    float* dx;
+    float* dy;
+    float* prevX; // Position au pas précédent, pour l'interpolation
+    float* prevY;
+    int count;
+} BallArrays;
+
+typedef enum {
+    PHYSICS_SCALAR,
+    PHYSICS_SSE2,
+    PHYSICS_AVX2
+} PhysicsBackend;
+
+bool allocBalls(BallArrays* balls, int count);
+void freeBalls(BallArrays* balls);
+PhysicsBackend detectPhysicsBackend();
+void setPhysicsBackend(PhysicsBackend backend);
+PhysicsBackend getPhysicsBackend();
+const char* getPhysicsBackendName();
+bool checkCollision(SimRect a, float ballX, float ballY);
+void moveBallRange(BallArrays* balls, int begin, int end, bool contain);
+int findCollisionInRange(const BallArrays* balls, SimRect player, int begin, int end);
+
+#endif
@@ -0,0 +1,191 @@
+#include "profile.h"
+
+#ifdef VALO_PROFILE
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "text.h"
+
+#define PROFILE_RING_MASK (PROFILE_RING_SIZE - 1)
+#define PROFILE_OVERLAY_X 10
+#define PROFILE_OVERLAY_Y 60
+#define PROFILE_GRAPH_HEIGHT 100
+#define PROFILE_TARGET_MS (1000.0 / 60.0)
+
+// Une mesure terminée. sequence vaut l'indice d'écriture + 1 une fois tous
+// les champs écrits, 0 pendant l'écriture : le lecteur ignore une entrée
+// dont la séquence a changé pendant sa copie.
+typedef struct {
+    atomic_uint_fast64_t sequence;
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+    int thread;
+} ProfileEvent;
+
+static ProfileEvent ring[PROFILE_RING_SIZE];
+static atomic_uint_fast64_t writeIndex;
+static atomic_int threadCount;
+static _Thread_local int threadId; // 0 tant que le thread n'a rien mesuré
+
+// Temps de frame, écrits et lus par le thread principal seulement
+static double frameMs[PROFILE_FRAME_HISTORY];
+static int frameCount = 0;
+static Uint64 lastFrameStart = 0;
+static bool overlayVisible = false;
+
+ProfileScope profileBegin(const char* name) {
+    ProfileScope scope = {name, SDL_GetPerformanceCounter()};
+    return scope;
+}
+
+static void recordEvent(const char* name, Uint64 start, Uint64 end) {
+    if (threadId == 0) threadId = atomic_fetch_add(&threadCount, 1) + 1;
+    uint_fast64_t index = atomic_fetch_add_explicit(&writeIndex, 1, memory_order_relaxed);
+    ProfileEvent* event = &ring[index & PROFILE_RING_MASK];
+    atomic_store_explicit(&event->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    event->thread = threadId;
+    atomic_store_explicit(&event->sequence, index + 1, memory_order_release);
+}
+
+void profileEnd(ProfileScope* scope) {
+    recordEvent(scope->name, scope->start, SDL_GetPerformanceCounter());
+}
+
+// Appelé au début de chaque frame (beginFrame) : clôt la frame précédente
+void profileFrame() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastFrameStart != 0) {
+        recordEvent("frame", lastFrameStart, now);
+        frameMs[frameCount % PROFILE_FRAME_HISTORY] = (double)(now - lastFrameStart) * 1000.0 / SDL_GetPerformanceFrequency();
+        frameCount++;
+    }
+    lastFrameStart = now;
+}
+
+// Copie cohérente d'une entrée, false si elle a été écrasée ou est en cours d'écriture
+static bool readEvent(uint_fast64_t index, ProfileEvent* copy) {
+    ProfileEvent* event = &ring[index & PROFILE_RING_MASK];
+    uint_fast64_t sequence = atomic_load_explicit(&event->sequence, memory_order_acquire);
+    if (sequence != index + 1) return false;
+    copy->name = event->name;
+    copy->start = event->start;
+    copy->end = event->end;
+    copy->thread = event->thread;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&event->sequence, memory_order_relaxed) == sequence;
+}
+
+// Écrit les mesures encore présentes dans le tampon, en microsecondes
+bool dumpProfileTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Impossible d'ecrire la trace %s\n", path);
+        return false;
+    }
+    uint_fast64_t end = atomic_load_explicit(&writeIndex, memory_order_acquire);
+    uint_fast64_t begin = end > PROFILE_RING_SIZE ? end - PROFILE_RING_SIZE : 0;
+    double microseconds = 1e6 / SDL_GetPerformanceFrequency();
+    // Les mesures sont rangées à leur fin : la plus ancienne n'est pas forcément la première
+    Uint64 origin = UINT64_MAX;
+    for (uint_fast64_t i = begin; i < end; i++) {
+        ProfileEvent event;
+        if (readEvent(i, &event) && event.start < origin) origin = event.start;
+    }
+    int written = 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (uint_fast64_t i = begin; i < end; i++) {
+        ProfileEvent event;
+        if (!readEvent(i, &event) || event.start < origin) continue;
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}\n",
+                written > 0 ? "," : "", event.name, event.thread, (event.start - origin) * microseconds,
+                (event.end - event.start) * microseconds);
+        written++;
+    }
+    fprintf(file, "]}\n");
+    bool ok = fclose(file) == 0;
+    if (ok) printf("Trace : %s (%d mesures)\n", path, written);
+    return ok;
+}
+
+// F3 : courbe, F4 : trace ; renvoie true si la touche était pour le profileur
+bool profileHandleEvent(const SDL_Event* event) {
+    if (event->type != SDL_KEYDOWN || event->key.repeat) return false;
+    if (event->key.keysym.sym == SDLK_F3) {
+        overlayVisible = !overlayVisible;
+        return true;
+    }
+    if (event->key.keysym.sym == SDLK_F4) {
+        dumpProfileTrace(PROFILE_TRACE_PATH);
+        return true;
+    }
+    return false;
+}
+
+static int compareMs(const void* a, const void* b) {
+    double left = *(const double*)a, right = *(const double*)b;
+    return (left > right) - (left < right);
+}
+
+// Une barre par frame, rouge au-delà de 16,7 ms, et les percentiles en texte
+void drawProfileOverlay(SDL_Renderer* renderer) {
+    if (!overlayVisible) return;
+    PROFILE_SCOPE("profileur");
+    int count = frameCount < PROFILE_FRAME_HISTORY ? frameCount : PROFILE_FRAME_HISTORY;
+    Uint8 r, g, b, a;
+    SDL_BlendMode blendMode;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+
+    char text[MAX_TEXT_LENGTH] = "";
+    if (count > 0) {
+        double sorted[PROFILE_FRAME_HISTORY];
+        for (int i = 0; i < count; i++) sorted[i] = frameMs[i];
+        qsort(sorted, count, sizeof(double), compareMs);
+        snprintf(text, sizeof(text), "p50 %.1f ms  p99 %.1f ms", sorted[(count - 1) * 50 / 100], sorted[(count - 1) * 99 / 100]);
+    }
+    int textWidth = 0, textHeight = 0;
+    measureText(getDefaultFont(), text, &textWidth, &textHeight);
+    SDL_Rect panel = {PROFILE_OVERLAY_X, PROFILE_OVERLAY_Y, PROFILE_FRAME_HISTORY, PROFILE_GRAPH_HEIGHT + textHeight + 12};
+    if (textWidth > panel.w) panel.w = textWidth;
+    panel.w += 8;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(renderer, &panel);
+
+    // Deux appels de rendu : toutes les barres sous la cible, puis toutes celles au-dessus
+    SDL_Rect fast[PROFILE_FRAME_HISTORY], slow[PROFILE_FRAME_HISTORY];
+    int fastCount = 0, slowCount = 0;
+    int graphBottom = panel.y + 4 + PROFILE_GRAPH_HEIGHT;
+    for (int i = 0; i < count; i++) {
+        double ms = frameMs[(frameCount - count + i) % PROFILE_FRAME_HISTORY];
+        int height = (int)(ms / PROFILE_GRAPH_MS * PROFILE_GRAPH_HEIGHT);
+        if (height > PROFILE_GRAPH_HEIGHT) height = PROFILE_GRAPH_HEIGHT;
+        if (height < 1) height = 1;
+        SDL_Rect bar = {panel.x + 4 + i, graphBottom - height, 1, height};
+        if (ms > PROFILE_TARGET_MS) {
+            slow[slowCount++] = bar;
+        } else {
+            fast[fastCount++] = bar;
+        }
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 220, 0, 255);
+    SDL_RenderFillRects(renderer, fast, fastCount);
+    SDL_SetRenderDrawColor(renderer, 230, 40, 40, 255);
+    SDL_RenderFillRects(renderer, slow, slowCount);
+    int targetY = graphBottom - (int)(PROFILE_TARGET_MS / PROFILE_GRAPH_MS * PROFILE_GRAPH_HEIGHT);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 120);
+    SDL_RenderDrawLine(renderer, panel.x + 4, targetY, panel.x + 4 + PROFILE_FRAME_HISTORY, targetY);
+
+    drawTextAt(getDefaultFont(), text, panel.x + 4, graphBottom + 4, (SDL_Color){255, 255, 255, 255});
+
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+// Profileur de frames, compilé seulement avec -DVALO_PROFILE (make profile).
+// PROFILE_SCOPE chronomètre le reste du bloc où il est placé et range la
+// mesure dans un tampon circulaire sans verrou, utilisable depuis n'importe
+// quel thread. F3 affiche la courbe des temps de frame avec p50/p99, F4 écrit
+// les dernières mesures au format trace_event de Chrome (chrome://tracing,
+// Perfetto). Sans VALO_PROFILE, toutes les macros disparaissent.
+
+#ifdef VALO_PROFILE
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#define PROFILE_RING_SIZE 65536      // Mesures gardées, puissance de 2 (~2 s de jeu)
+#define PROFILE_FRAME_HISTORY 240    // Frames de la courbe (4 s à 60 images/s)
+#define PROFILE_GRAPH_MS 33.3        // Hauteur de la courbe : deux frames à 60 images/s
+#define PROFILE_TRACE_PATH "trace.json"
+
+typedef struct {
+    const char* name; // Chaîne littérale : seul le pointeur est gardé
+    Uint64 start;
+} ProfileScope;
+
+ProfileScope profileBegin(const char* name);
+void profileEnd(ProfileScope* scope);
+void profileFrame();
+bool profileHandleEvent(const SDL_Event* event);
+void drawProfileOverlay(SDL_Renderer* renderer);
+bool dumpProfileTrace(const char* path);
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+// La mesure se termine à la sortie du bloc, quel que soit le chemin (return, break)
+#define PROFILE_SCOPE(name) \
+    ProfileScope PROFILE_JOIN(profileScope, __LINE__) __attribute__((cleanup(profileEnd))) = profileBegin(name)
+#define PROFILE_FRAME() profileFrame()
+#define PROFILE_EVENT(event) profileHandleEvent(event)
+#define PROFILE_OVERLAY(renderer) drawProfileOverlay(renderer)
+#define PROFILE_DUMP(path) dumpProfileTrace(path)
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_EVENT(event) 0
+#define PROFILE_OVERLAY(renderer) ((void)0)
+#define PROFILE_DUMP(path) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#include "rank.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char difficulte[20];
+    int* tree;  // Fenwick indexé de 1 à RANK_MAX_TIME + 1 (temps + 1)
+    int total;
+} RankTable;
+
+static RankTable tables[MAX_RANK_TABLES];
+static int tableCount = 0;
+static bool rankReady = false;
+// Écrit par le thread d'écriture pendant le chargement, lu par le thread principal
+static pthread_mutex_t rankMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int clampTime(int time) {
+    if (time < 0) return 0;
+    return time > RANK_MAX_TIME ? RANK_MAX_TIME : time;
+}
+
+// Appelé avec rankMutex tenu
+static RankTable* findTable(const char* difficulte, bool create) {
+    for (int i = 0; i < tableCount; i++) {
+        if (strcmp(tables[i].difficulte, difficulte) == 0) return &tables[i];
+    }
+    if (!create || tableCount == MAX_RANK_TABLES) return NULL;
+    RankTable* table = &tables[tableCount];
+    table->tree = calloc(RANK_MAX_TIME + 2, sizeof(int));
+    if (!table->tree) return NULL;
+    snprintf(table->difficulte, sizeof(table->difficulte), "%s", difficulte);
+    table->total = 0;
+    tableCount++;
+    return table;
+}
+
+// Nombre de scores de temps <= time
+static int countUpTo(const RankTable* table, int time) {
+    int count = 0;
+    for (int i = clampTime(time) + 1; i > 0; i -= i & -i) {
+        count += table->tree[i];
+    }
+    return count;
+}
+
+void addRankScores(const char* difficulte, int time, int count) {
+    pthread_mutex_lock(&rankMutex);
+    RankTable* table = findTable(difficulte, true);
+    if (table) {
+        for (int i = clampTime(time) + 1; i <= RANK_MAX_TIME + 1; i += i & -i) {
+            table->tree[i] += count;
+        }
+        table->total += count;
+    }
+    pthread_mutex_unlock(&rankMutex);
+}
+
+// Rang qu'obtiendrait ce temps : 1 + nombre de temps strictement meilleurs.
+// Les temps égaux partagent le même rang.
+bool getScoreRank(const char* difficulte, int time, int* rank, int* total) {
+    pthread_mutex_lock(&rankMutex);
+    RankTable* table = findTable(difficulte, false);
+    *total = table ? table->total : 0;
+    *rank = 1 + (table ? table->total - countUpTo(table, time) : 0);
+    bool ready = rankReady;
+    pthread_mutex_unlock(&rankMutex);
+    return ready;
+}
+
+void setRankReady(bool ready) {
+    pthread_mutex_lock(&rankMutex);
+    rankReady = ready;
+    pthread_mutex_unlock(&rankMutex);
+}
+
+bool isRankReady() {
+    pthread_mutex_lock(&rankMutex);
+    bool ready = rankReady;
+    pthread_mutex_unlock(&rankMutex);
+    return ready;
+}
+
+void cleanupRanks() {
+    pthread_mutex_lock(&rankMutex);
+    for (int i = 0; i < tableCount; i++) {
+        free(tables[i].tree);
+    }
+    memset(tables, 0, sizeof(tables));
+    tableCount = 0;
+    rankReady = false;
+    pthread_mutex_unlock(&rankMutex);
+}
@@ -0,0 +1,20 @@
+#ifndef RANK_H
+#define RANK_H
+
+// Nombre de scores par temps de survie, par difficulté, dans un arbre de
+// Fenwick : « #N sur M » se calcule en O(log T) sans requête. Rempli une fois
+// depuis la base par le thread d'écriture des scores, puis tenu à jour à
+// chaque score soumis localement.
+
+#include <stdbool.h>
+
+#define RANK_MAX_TIME 65535 // Secondes ; les temps plus longs partagent la dernière case
+#define MAX_RANK_TABLES 8
+
+void addRankScores(const char* difficulte, int time, int count);
+bool getScoreRank(const char* difficulte, int time, int* rank, int* total);
+void setRankReady(bool ready);
+bool isRankReady();
+void cleanupRanks();
+
+#endif
@@ -0,0 +1,320 @@
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC "VRPL"
+#define REPLAY_HEADER_SIZE 15 // Magique, version, drapeaux, difficulté, graine
+#define MAX_VARINT_SIZE 10
+#define BALL_STATE_ARRAYS 6   // x, y, dx, dy, prevX, prevY
+
+// État complet d'une simulation à un pas donné. La grille est copiée aussi :
+// l'ordre de ses listes décide de l'ordre des chocs entre balles.
+struct ReplaySnapshot {
+    uint64_t rngState;
+    SimRect player;
+    int prevPlayerX, prevPlayerY;
+    uint32_t tick;
+    bool over;
+    int run;
+    uint32_t runTick;
+    float* balls;
+    int* links; // next, prev, cellOf puis cellHead
+};
+
+void replayInit(Replay* replay, const Simulation* sim, uint64_t seed) {
+    memset(replay, 0, sizeof(Replay));
+    replay->seed = seed;
+    replay->difficulty = sim->difficulty;
+    replay->ballCount = sim->ballCount;
+    replay->ballSpeed = sim->ballSpeed;
+    if (sim->ballCollisions) replay->flags |= REPLAY_FLAG_COLLISIONS;
+    if (!replayMatchesDifficulty(replay)) replay->flags |= REPLAY_FLAG_UNRANKED;
+}
+
+// Réglages exactement ceux de la difficulté annoncée, sans chocs entre balles :
+// seules ces parties peuvent compter pour le classement
+bool replayMatchesDifficulty(const Replay* replay) {
+    int ballCount, ballSpeed;
+    getDifficultyParams(replay->difficulty, &ballCount, &ballSpeed);
+    return replay->ballCount == ballCount && replay->ballSpeed == ballSpeed &&
+           !(replay->flags & REPLAY_FLAG_COLLISIONS);
+}
+
+// Entrée d'un pas, à appeler juste avant simStep ; false si la mémoire manque
+bool replayRecord(Replay* replay, SimInput input) {
+    if (replay->runCount > 0 && replay->runs[replay->runCount - 1].input == input) {
+        replay->runs[replay->runCount - 1].length++;
+        replay->tickCount++;
+        return true;
+    }
+    if (replay->runCount == replay->runCapacity) {
+        int capacity = replay->runCapacity > 0 ? replay->runCapacity * 2 : 64;
+        ReplayRun* runs = realloc(replay->runs, capacity * sizeof(ReplayRun));
+        if (!runs) {
+            printf("Erreur d'allocation memoire pour l'enregistrement\n");
+            return false;
+        }
+        replay->runs = runs;
+        replay->runCapacity = capacity;
+    }
+    replay->runs[replay->runCount++] = (ReplayRun){input, 1};
+    replay->tickCount++;
+    return true;
+}
+
+void replayFinish(Replay* replay, const Simulation* sim) {
+    if (sim->over) replay->flags |= REPLAY_FLAG_OVER;
+}
+
+void replayFree(Replay* replay) {
+    free(replay->runs);
+    memset(replay, 0, sizeof(Replay));
+}
+
+static int writeVarint(uint8_t* out, uint64_t value) {
+    int size = 0;
+    while (value >= 0x80) {
+        out[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = (uint8_t)value;
+    return size;
+}
+
+static bool readVarint(const uint8_t* data, size_t size, size_t* offset, uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && *offset < size; shift += 7) {
+        uint8_t byte = data[(*offset)++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Renvoie la taille écrite en octets, -1 en cas d'erreur
+long replaySave(const Replay* replay, const char* path) {
+    uint8_t* data = malloc(REPLAY_HEADER_SIZE + MAX_VARINT_SIZE * (4 + (size_t)replay->runCount));
+    if (!data) return -1;
+    memcpy(data, REPLAY_MAGIC, 4);
+    data[4] = REPLAY_VERSION;
+    data[5] = replay->flags;
+    data[6] = (uint8_t)replay->difficulty;
+    for (int i = 0; i < 8; i++) {
+        data[7 + i] = (uint8_t)(replay->seed >> (8 * i));
+    }
+    size_t size = REPLAY_HEADER_SIZE;
+    size += writeVarint(data + size, (uint64_t)replay->ballCount);
+    size += writeVarint(data + size, (uint64_t)replay->ballSpeed);
+    size += writeVarint(data + size, replay->tickCount);
+    size += writeVarint(data + size, (uint64_t)replay->runCount);
+    for (int i = 0; i < replay->runCount; i++) {
+        size += writeVarint(data + size, (uint64_t)replay->runs[i].length << 4 | replay->runs[i].input);
+    }
+    FILE* file = fopen(path, "wb");
+    bool written = file && fwrite(data, 1, size, file) == size;
+    if (file && fclose(file) != 0) written = false;
+    free(data);
+    if (!written) {
+        printf("Impossible d'ecrire l'enregistrement %s\n", path);
+        return -1;
+    }
+    return (long)size;
+}
+
+static bool parseReplay(Replay* replay, const uint8_t* data, size_t size) {
+    if (size < REPLAY_HEADER_SIZE || memcmp(data, REPLAY_MAGIC, 4) != 0 || data[4] != REPLAY_VERSION ||
+        data[6] >= DIFFICULTY_COUNT) {
+        return false;
+    }
+    replay->flags = data[5];
+    replay->difficulty = (Difficulty)data[6];
+    for (int i = 0; i < 8; i++) {
+        replay->seed |= (uint64_t)data[7 + i] << (8 * i);
+    }
+    size_t offset = REPLAY_HEADER_SIZE;
+    uint64_t ballCount, ballSpeed, tickCount, runCount;
+    if (!readVarint(data, size, &offset, &ballCount) || !readVarint(data, size, &offset, &ballSpeed) ||
+        !readVarint(data, size, &offset, &tickCount) || !readVarint(data, size, &offset, &runCount) ||
+        ballCount == 0 || ballCount > REPLAY_MAX_BALLS || ballSpeed == 0 || ballSpeed > WORLD_WIDTH ||
+        tickCount > UINT32_MAX || runCount > size - offset) {
+        return false;
+    }
+    replay->ballCount = (int)ballCount;
+    replay->ballSpeed = (int)ballSpeed;
+    replay->tickCount = (uint32_t)tickCount;
+    replay->runs = malloc((runCount > 0 ? runCount : 1) * sizeof(ReplayRun));
+    if (!replay->runs) return false;
+    replay->runCapacity = (int)runCount;
+    // Chaque plage compte au moins un pas et leur somme doit retomber sur tickCount
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < runCount; i++) {
+        uint64_t value;
+        if (!readVarint(data, size, &offset, &value) || value >> 4 == 0) return false;
+        total += value >> 4;
+        if (total > tickCount) return false;
+        replay->runs[replay->runCount++] = (ReplayRun){(SimInput)(value & 0x0F), (uint32_t)(value >> 4)};
+    }
+    return total == tickCount && offset == size;
+}
+
+bool replayLoad(Replay* replay, const char* path) {
+    memset(replay, 0, sizeof(Replay));
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Impossible d'ouvrir l'enregistrement %s\n", path);
+        return false;
+    }
+    uint8_t* data = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc(size);
+    }
+    bool loaded = data && fread(data, 1, size, file) == (size_t)size && parseReplay(replay, data, size);
+    fclose(file);
+    free(data);
+    if (!loaded) {
+        printf("Enregistrement invalide : %s\n", path);
+        replayFree(replay);
+    }
+    return loaded;
+}
+
+// Simulation dans l'état initial de la partie enregistrée
+bool replayStartSimulation(const Replay* replay, Simulation* sim) {
+    if (!simInit(sim, replay->ballCount, replay->ballSpeed, replay->seed)) return false;
+    sim->difficulty = replay->difficulty;
+    if ((replay->flags & REPLAY_FLAG_COLLISIONS) && !enableBallCollisions(sim)) {
+        simFree(sim);
+        return false;
+    }
+    return true;
+}
+
+// Rejoue toutes les entrées d'une traite, sans instantané ; renvoie les pas simulés
+uint32_t replayRun(const Replay* replay, Simulation* sim) {
+    for (int i = 0; i < replay->runCount && !sim->over; i++) {
+        for (uint32_t step = 0; step < replay->runs[i].length && !sim->over; step++) {
+            simStep(sim, replay->runs[i].input);
+        }
+    }
+    return sim->tick;
+}
+
+static float* ballArray(const BallArrays* balls, int index) {
+    float* arrays[BALL_STATE_ARRAYS] = {balls->x, balls->y, balls->dx, balls->dy, balls->prevX, balls->prevY};
+    return arrays[index];
+}
+
+static bool takeSnapshot(ReplayPlayer* player) {
+    if (player->snapshotCount == player->snapshotCapacity) {
+        int capacity = player->snapshotCapacity > 0 ? player->snapshotCapacity * 2 : 16;
+        ReplaySnapshot* snapshots = realloc(player->snapshots, capacity * sizeof(ReplaySnapshot));
+        if (!snapshots) return false;
+        player->snapshots = snapshots;
+        player->snapshotCapacity = capacity;
+    }
+    const Simulation* sim = player->sim;
+    size_t count = (size_t)sim->ballCount;
+    ReplaySnapshot* snapshot = &player->snapshots[player->snapshotCount];
+    memset(snapshot, 0, sizeof(ReplaySnapshot));
+    snapshot->balls = malloc(BALL_STATE_ARRAYS * count * sizeof(float));
+    if (sim->grid) snapshot->links = malloc((3 * count + GRID_CELLS) * sizeof(int));
+    if (!snapshot->balls || (sim->grid && !snapshot->links)) {
+        free(snapshot->balls);
+        free(snapshot->links);
+        printf("Erreur d'allocation memoire pour les instantanes\n");
+        return false;
+    }
+    snapshot->rngState = sim->rngState;
+    snapshot->player = sim->player;
+    snapshot->prevPlayerX = sim->prevPlayerX;
+    snapshot->prevPlayerY = sim->prevPlayerY;
+    snapshot->tick = sim->tick;
+    snapshot->over = sim->over;
+    snapshot->run = player->run;
+    snapshot->runTick = player->runTick;
+    for (int i = 0; i < BALL_STATE_ARRAYS; i++) {
+        memcpy(snapshot->balls + i * count, ballArray(&sim->balls, i), count * sizeof(float));
+    }
+    if (sim->grid) {
+        memcpy(snapshot->links, sim->grid->next, count * sizeof(int));
+        memcpy(snapshot->links + count, sim->grid->prev, count * sizeof(int));
+        memcpy(snapshot->links + 2 * count, sim->grid->cellOf, count * sizeof(int));
+        memcpy(snapshot->links + 3 * count, sim->grid->cellHead, GRID_CELLS * sizeof(int));
+    }
+    player->snapshotCount++;
+    return true;
+}
+
+static void restoreSnapshot(ReplayPlayer* player, const ReplaySnapshot* snapshot) {
+    Simulation* sim = player->sim;
+    size_t count = (size_t)sim->ballCount;
+    sim->rngState = snapshot->rngState;
+    sim->player = snapshot->player;
+    sim->prevPlayerX = snapshot->prevPlayerX;
+    sim->prevPlayerY = snapshot->prevPlayerY;
+    sim->tick = snapshot->tick;
+    sim->over = snapshot->over;
+    player->run = snapshot->run;
+    player->runTick = snapshot->runTick;
+    for (int i = 0; i < BALL_STATE_ARRAYS; i++) {
+        memcpy(ballArray(&sim->balls, i), snapshot->balls + i * count, count * sizeof(float));
+    }
+    if (sim->grid) {
+        memcpy(sim->grid->next, snapshot->links, count * sizeof(int));
+        memcpy(sim->grid->prev, snapshot->links + count, count * sizeof(int));
+        memcpy(sim->grid->cellOf, snapshot->links + 2 * count, count * sizeof(int));
+        memcpy(sim->grid->cellHead, snapshot->links + 3 * count, GRID_CELLS * sizeof(int));
+    }
+}
+
+// La simulation doit sortir de replayStartSimulation
+bool replayPlayerInit(ReplayPlayer* player, const Replay* replay, Simulation* sim) {
+    memset(player, 0, sizeof(ReplayPlayer));
+    player->replay = replay;
+    player->sim = sim;
+    return takeSnapshot(player);
+}
+
+// Joue un pas enregistré ; false une fois l'enregistrement épuisé
+bool replayPlayerStep(ReplayPlayer* player) {
+    const Replay* replay = player->replay;
+    Simulation* sim = player->sim;
+    if (sim->over || sim->tick >= replay->tickCount) return false;
+    const ReplayRun* run = &replay->runs[player->run];
+    simStep(sim, run->input);
+    if (++player->runTick == run->length) {
+        player->run++;
+        player->runTick = 0;
+    }
+    // Les instantanés sont pris au premier passage, dans l'ordre
+    if (sim->tick == (uint32_t)player->snapshotCount * REPLAY_SNAPSHOT_INTERVAL) {
+        takeSnapshot(player);
+    }
+    return true;
+}
+
+// Repart de l'instantané le plus proche avant tick, puis rejoue les pas manquants
+bool replayPlayerSeek(ReplayPlayer* player, uint32_t tick) {
+    if (tick > player->replay->tickCount) tick = player->replay->tickCount;
+    int index = (int)(tick / REPLAY_SNAPSHOT_INTERVAL);
+    if (index >= player->snapshotCount) index = player->snapshotCount - 1;
+    const ReplaySnapshot* snapshot = &player->snapshots[index];
+    if (tick < player->sim->tick || snapshot->tick > player->sim->tick) {
+        restoreSnapshot(player, snapshot);
+    }
+    while (player->sim->tick < tick) {
+        if (!replayPlayerStep(player)) return false;
+    }
+    return true;
+}
+
+void replayPlayerFree(ReplayPlayer* player) {
+    for (int i = 0; i < player->snapshotCount; i++) {
+        free(player->snapshots[i].balls);
+        free(player->snapshots[i].links);
+    }
+    free(player->snapshots);
+    memset(player, 0, sizeof(ReplayPlayer));
+}
@@ -0,0 +1,72 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Enregistrement d'une partie : graine, réglages et flèches enfoncées à chaque
+// pas. La simulation étant déterministe, cela suffit à la rejouer à l'identique.
+//
+// Format du fichier (entiers little-endian, varint = 7 bits par octet) :
+//   "VRPL", version, drapeaux, difficulté (1 octet chacun), graine (8 octets),
+//   balles, vitesse, pas enregistrés, nombre de plages (varint)
+//   puis une varint par plage d'entrées identiques : (longueur << 4) | flèches
+// Les flèches ne changent que quelques fois par seconde : une partie de
+// plusieurs minutes tient en quelques centaines d'octets.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+
+#define REPLAY_VERSION 1
+#define REPLAY_LAST_PATH "derniere.replay"
+#define REPLAY_SNAPSHOT_INTERVAL 600 // Pas entre deux instantanés (10 s) : borne le coût d'un retour arrière
+#define REPLAY_MAX_BALLS (1 << 24)   // Refuse les fichiers corrompus avant d'allouer
+
+#define REPLAY_FLAG_COLLISIONS 0x01 // Chocs entre balles activés (--collisions)
+#define REPLAY_FLAG_OVER 0x02       // Partie terminée par une collision
+#define REPLAY_FLAG_UNRANKED 0x04   // Réglages hors difficulté (--balls, --collisions) : jamais classée
+
+typedef struct {
+    SimInput input;
+    uint32_t length; // Nombre de pas consécutifs avec ces flèches
+} ReplayRun;
+
+typedef struct {
+    uint64_t seed;
+    Difficulty difficulty;
+    int ballCount;
+    int ballSpeed;
+    uint8_t flags;
+    uint32_t tickCount; // Pas enregistrés, soit le temps de survie si REPLAY_FLAG_OVER
+    ReplayRun* runs;
+    int runCount;
+    int runCapacity;
+} Replay;
+
+typedef struct ReplaySnapshot ReplaySnapshot;
+
+// Lecture d'un enregistrement, avec retour arrière par instantanés
+typedef struct {
+    const Replay* replay;
+    Simulation* sim;
+    int run;          // Plage qui fournit l'entrée du prochain pas
+    uint32_t runTick; // Pas déjà joués dans cette plage
+    ReplaySnapshot* snapshots; // Un tous les REPLAY_SNAPSHOT_INTERVAL pas, pris au passage
+    int snapshotCount;
+    int snapshotCapacity;
+} ReplayPlayer;
+
+void replayInit(Replay* replay, const Simulation* sim, uint64_t seed);
+bool replayRecord(Replay* replay, SimInput input);
+void replayFinish(Replay* replay, const Simulation* sim);
+void replayFree(Replay* replay);
+bool replayMatchesDifficulty(const Replay* replay);
+long replaySave(const Replay* replay, const char* path);
+bool replayLoad(Replay* replay, const char* path);
+bool replayStartSimulation(const Replay* replay, Simulation* sim);
+uint32_t replayRun(const Replay* replay, Simulation* sim);
+
+bool replayPlayerInit(ReplayPlayer* player, const Replay* replay, Simulation* sim);
+bool replayPlayerStep(ReplayPlayer* player);
+bool replayPlayerSeek(ReplayPlayer* player, uint32_t tick);
+void replayPlayerFree(ReplayPlayer* player);
+
+#endif
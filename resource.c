@@ -0,0 +1,173 @@
+#include "resource.h"
+#include "pack.h"
+#include <stdio.h>
+#include <string.h>
+
+static Resource resources[MAX_RESOURCES];
+static bool resourceUsed[MAX_RESOURCES];
+static Uint32 useCounter = 0;
+static int loadCount = 0; // Chargements réels depuis le disque
+
+static const char* kindNames[] = {"texture", "police", "son", "musique"};
+
+static void unloadResource(Resource* resource) {
+    switch (resource->kind) {
+        case RESOURCE_TEXTURE:
+            releaseImage(resource->image);
+            break;
+        case RESOURCE_FONT:
+            if (resource->font) TTF_CloseFont(resource->font);
+            break;
+        case RESOURCE_CHUNK:
+            if (resource->chunk) Mix_FreeChunk(resource->chunk);
+            break;
+        case RESOURCE_MUSIC:
+            if (resource->music) Mix_FreeMusic(resource->music);
+            break;
+    }
+    resourceUsed[resource - resources] = false;
+    memset(resource, 0, sizeof(Resource));
+}
+
+// Évince la ressource inutilisée la plus ancienne si le cache déborde
+static void evictIdle(bool force) {
+    int idleCount = 0;
+    int oldest = -1;
+    for (int i = 0; i < MAX_RESOURCES; i++) {
+        if (!resourceUsed[i] || resources[i].refCount > 0) continue;
+        idleCount++;
+        if (oldest < 0 || resources[i].lastUse < resources[oldest].lastUse) oldest = i;
+    }
+    if (oldest >= 0 && (force || idleCount > MAX_IDLE_RESOURCES)) {
+        unloadResource(&resources[oldest]);
+    }
+}
+
+static Resource* findResource(ResourceKind kind, const char* path, int size) {
+    for (int i = 0; i < MAX_RESOURCES; i++) {
+        if (resourceUsed[i] && resources[i].kind == kind && resources[i].size == size &&
+            strcmp(resources[i].path, path) == 0) {
+            return &resources[i];
+        }
+    }
+    return NULL;
+}
+
+static Resource* loadResource(ResourceKind kind, const char* path, int size) {
+    int slot = -1;
+    for (int i = 0; i < MAX_RESOURCES && slot < 0; i++) {
+        if (!resourceUsed[i]) slot = i;
+    }
+    if (slot < 0) {
+        evictIdle(true);
+        for (int i = 0; i < MAX_RESOURCES && slot < 0; i++) {
+            if (!resourceUsed[i]) slot = i;
+        }
+        if (slot < 0) {
+            printf("Cache de ressources plein : %s\n", path);
+            return NULL;
+        }
+    }
+
+    Resource* resource = &resources[slot];
+    memset(resource, 0, sizeof(Resource));
+    resource->kind = kind;
+    resource->size = size;
+    snprintf(resource->path, sizeof(resource->path), "%s", path);
+    bool loaded = false;
+    const PackEntry* entry = NULL; // Version pré-décodée du paquet, si présente
+    switch (kind) {
+        case RESOURCE_TEXTURE:
+            resource->image = requestImage(path, true);
+            loaded = resource->image != NULL;
+            break;
+        case RESOURCE_FONT:
+            entry = findPackEntry(path, PACK_FONT);
+            resource->font = entry ? loadPackFont(entry, size) : TTF_OpenFont(path, size);
+            loaded = resource->font != NULL;
+            break;
+        case RESOURCE_CHUNK:
+            entry = findPackEntry(path, PACK_SOUND);
+            resource->chunk = entry ? loadPackChunk(entry) : Mix_LoadWAV(path);
+            loaded = resource->chunk != NULL;
+            break;
+        case RESOURCE_MUSIC:
+            entry = findPackEntry(path, PACK_MUSIC);
+            resource->music = entry ? loadPackMusic(entry) : Mix_LoadMUS(path);
+            loaded = resource->music != NULL;
+            break;
+    }
+    if (!loaded) {
+        printf("Erreur de chargement (%s) : %s : %s\n", kindNames[kind], path, SDL_GetError());
+        return NULL;
+    }
+    resourceUsed[slot] = true;
+    loadCount++;
+    return resource;
+}
+
+static Resource* acquire(ResourceKind kind, const char* path, int size) {
+    Resource* resource = findResource(kind, path, size);
+    if (!resource) resource = loadResource(kind, path, size);
+    if (!resource) return NULL;
+    resource->refCount++;
+    resource->lastUse = ++useCounter;
+    return resource;
+}
+
+Resource* acquireResource(ResourceKind kind, const char* path) {
+    return acquire(kind, path, 0);
+}
+
+Resource* acquireFont(const char* path, int size) {
+    return acquire(RESOURCE_FONT, path, size);
+}
+
+// La ressource reste en cache tant qu'il reste de la place
+void releaseResource(Resource* resource) {
+    if (!resource || resource->refCount <= 0) return;
+    resource->refCount--;
+    resource->lastUse = ++useCounter;
+    if (resource->refCount == 0) evictIdle(false);
+}
+
+// Un écran acquiert son ensemble avant que le précédent ne libère le sien :
+// les ressources communes ne sont jamais rechargées
+void acquireResourceSet(const ResourceDef* defs, int count, Resource** out) {
+    for (int i = 0; i < count; i++) {
+        out[i] = acquireResource(defs[i].kind, defs[i].path);
+    }
+}
+
+void releaseResourceSet(Resource** set, int count) {
+    for (int i = 0; i < count; i++) {
+        releaseResource(set[i]);
+        set[i] = NULL;
+    }
+}
+
+void cleanupResources() {
+    for (int i = 0; i < MAX_RESOURCES; i++) {
+        if (resourceUsed[i]) unloadResource(&resources[i]);
+    }
+}
+
+int getResourceLoadCount() {
+    return loadCount;
+}
+
+SDL_Texture* getTexture(const Resource* resource) {
+    return getImageTexture(resource ? resource->image : NULL);
+}
+
+TTF_Font* getFont(const Resource* resource) {
+    return resource ? resource->font : NULL;
+}
+
+Mix_Chunk* getChunk(const Resource* resource) {
+    return resource ? resource->chunk : NULL;
+}
+
+Mix_Music* getMusic(const Resource* resource) {
+    return resource ? resource->music : NULL;
+}
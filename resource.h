@@ -0,0 +1,57 @@
+#ifndef RESOURCE_H
+#define RESOURCE_H
+
+// Cache central des ressources, indexé par chemin et type, avec compteur de
+// références. Une ressource libérée reste en cache (inutilisée) pour que
+// revenir sur un écran ne recharge rien ; seules les plus anciennes sont
+// évincées au-delà de MAX_IDLE_RESOURCES.
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+#include "loader.h"
+
+#define MAX_RESOURCES 64
+#define MAX_IDLE_RESOURCES 16
+#define MAX_RESOURCE_PATH MAX_IMAGE_PATH
+
+typedef enum {
+    RESOURCE_TEXTURE, // Décodée en arrière-plan par le chargeur
+    RESOURCE_FONT,
+    RESOURCE_CHUNK,
+    RESOURCE_MUSIC
+} ResourceKind;
+
+typedef struct {
+    ResourceKind kind;
+    char path[MAX_RESOURCE_PATH];
+    int size;            // Taille de police, 0 pour les autres types
+    int refCount;
+    Uint32 lastUse;      // Ordre d'éviction des ressources inutilisées
+    AsyncImage* image;
+    TTF_Font* font;
+    Mix_Chunk* chunk;
+    Mix_Music* music;
+} Resource;
+
+// Ressources d'un écran, acquises à l'entrée et libérées à la sortie
+typedef struct {
+    ResourceKind kind;
+    const char* path;
+} ResourceDef;
+
+Resource* acquireResource(ResourceKind kind, const char* path);
+Resource* acquireFont(const char* path, int size);
+void releaseResource(Resource* resource);
+void acquireResourceSet(const ResourceDef* defs, int count, Resource** resources);
+void releaseResourceSet(Resource** resources, int count);
+void cleanupResources();
+int getResourceLoadCount();
+
+SDL_Texture* getTexture(const Resource* resource);
+TTF_Font* getFont(const Resource* resource);
+Mix_Chunk* getChunk(const Resource* resource);
+Mix_Music* getMusic(const Resource* resource);
+
+#endif
@@ -0,0 +1,148 @@
+#include "scene.h"
+#include "timing.h"
+#include "loader.h"
+#include "profile.h"
+#include "bot.h"
+#include <stdio.h>
+
+typedef enum {
+    TRANSITION_NONE,
+    TRANSITION_SWITCH,
+    TRANSITION_PUSH,
+    TRANSITION_POP,
+    TRANSITION_QUIT
+} TransitionKind;
+
+static SDL_Renderer* sceneRenderer = NULL;
+static const Scene* stack[MAX_SCENE_DEPTH];
+static int depth = 0;
+// Un seul changement en attente par frame ; quitter l'emporte sur les autres
+static TransitionKind pendingKind = TRANSITION_NONE;
+static const Scene* pendingScene = NULL;
+
+static void request(TransitionKind kind, const Scene* scene) {
+    if (pendingKind != TRANSITION_NONE && kind != TRANSITION_QUIT) return;
+    pendingKind = kind;
+    pendingScene = scene;
+}
+
+void switchScene(const Scene* scene) {
+    request(TRANSITION_SWITCH, scene);
+}
+
+void pushScene(const Scene* scene) {
+    request(TRANSITION_PUSH, scene);
+}
+
+void popScene() {
+    request(TRANSITION_POP, NULL);
+}
+
+void quitScenes() {
+    request(TRANSITION_QUIT, NULL);
+}
+
+static bool enterScene(const Scene* scene) {
+    if (scene->enter && !scene->enter()) {
+        printf("Ecran %s indisponible\n", scene->name);
+        return false;
+    }
+    return true;
+}
+
+static void exitScene(const Scene* scene) {
+    if (scene->exit) scene->exit();
+}
+
+// Applique les changements en attente, y compris ceux demandés par un enter ;
+// renvoie true si la scène du sommet a changé
+static bool applyTransitions() {
+    bool changed = false;
+    while (pendingKind != TRANSITION_NONE) {
+        TransitionKind kind = pendingKind;
+        const Scene* scene = pendingScene;
+        pendingKind = TRANSITION_NONE;
+        pendingScene = NULL;
+        switch (kind) {
+            case TRANSITION_SWITCH:
+                if (depth == 0) {
+                    if (enterScene(scene)) stack[depth++] = scene;
+                } else if (enterScene(scene)) {
+                    const Scene* previous = stack[depth - 1];
+                    stack[depth - 1] = scene;
+                    exitScene(previous);
+                }
+                break;
+            case TRANSITION_PUSH:
+                if (depth == MAX_SCENE_DEPTH) {
+                    printf("Pile d'ecrans pleine, %s ignore\n", scene->name);
+                } else if (enterScene(scene)) {
+                    stack[depth++] = scene;
+                }
+                break;
+            case TRANSITION_POP:
+                if (depth > 0) exitScene(stack[--depth]);
+                break;
+            case TRANSITION_QUIT:
+                while (depth > 0) exitScene(stack[--depth]);
+                break;
+            case TRANSITION_NONE:
+                break;
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+// SDL_PollEvent de la boucle ; les touches du profileur (F3, F4) sont
+// consommées ici quand il est compilé
+static int pollEvent(SDL_Event* event) {
+    PROFILE_SCOPE("SDL_PollEvent");
+    int pending;
+    do {
+        pending = SDL_PollEvent(event);
+    } while (pending && PROFILE_EVENT(event));
+    return pending;
+}
+
+// Fin du rendu d'une image : surcouche du profileur éventuelle puis affichage,
+// mesuré par le bot quand il joue
+static void presentFrame() {
+    botFrame();
+    PROFILE_OVERLAY(sceneRenderer);
+    PROFILE_SCOPE("SDL_RenderPresent");
+    SDL_RenderPresent(sceneRenderer);
+}
+
+// Boucle principale, jusqu'à ce que la pile soit vide
+void runScenes(SDL_Renderer* renderer, const Scene* first) {
+    sceneRenderer = renderer;
+    switchScene(first);
+    bool entered = applyTransitions();
+    SDL_Event event;
+
+    while (depth > 0) {
+        double deltaTime = beginFrame();
+        // Le temps passé dans enter (chargements) ne compte pas pour la nouvelle scène
+        if (entered) deltaTime = 0.0;
+        const Scene* scene = stack[depth - 1];
+
+        // Après une demande de changement, les événements restants vont à la scène suivante
+        while (pendingKind == TRANSITION_NONE && pollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                quitScenes();
+            } else if (scene->handleEvent) {
+                scene->handleEvent(&event);
+            }
+        }
+        if (pendingKind == TRANSITION_NONE && scene->update) {
+            PROFILE_SCOPE(scene->name);
+            scene->update(deltaTime);
+        }
+        if (scene->render) scene->render();
+        presentFrame();
+        pumpLoader();
+        endFrame();
+        entered = applyTransitions();
+    }
+}
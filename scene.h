@@ -0,0 +1,34 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+// Gestionnaire d'écrans : une pile de scènes et une seule boucle principale.
+// Seule la scène du sommet reçoit les événements et est mise à jour puis
+// dessinée. Les changements demandés pendant une frame (switchScene, pushScene,
+// popScene, quitScenes) sont appliqués à la fin de celle-ci : aucun écran n'en
+// appelle un autre, la profondeur de pile reste la même après des milliers de
+// parties. Au remplacement, la nouvelle scène entre avant que l'ancienne ne
+// sorte, comme pour les ensembles de ressources : les ressources communes ne
+// sont pas rechargées.
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#define MAX_SCENE_DEPTH 4 // Écran de base et une surcouche (classement, pause)
+
+// Tous les crochets sont facultatifs
+typedef struct {
+    const char* name;                            // Chaîne littérale, reprise par le profileur
+    bool (*enter)();                             // false : la scène n'est pas entrée, la pile ne change pas
+    void (*exit)();                              // Libère tout ce que enter a acquis
+    void (*handleEvent)(const SDL_Event* event);
+    void (*update)(double deltaTime);            // Non appelé si un changement est déjà demandé
+    void (*render)();                            // Avant presentFrame, qui affiche l'image
+} Scene;
+
+void runScenes(SDL_Renderer* renderer, const Scene* first);
+void switchScene(const Scene* scene);
+void pushScene(const Scene* scene);
+void popScene();
+void quitScenes();
+
+#endif
@@ -0,0 +1,395 @@
+#include "scores.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Enregistrements de taille fixe ajoutés en fin de journal. Un bloc FLUSHED
+// suit chaque INSERT réussi : au lancement, les scores au-delà du total
+// écrit sont rejoués. Un arrêt entre l'INSERT et ce bloc rejoue le lot.
+typedef enum {
+    JOURNAL_SCORE = 1,
+    JOURNAL_FLUSHED
+} JournalType;
+
+typedef struct {
+    uint32_t type;
+    int32_t value; // Temps du score, ou nombre de scores écrits
+    char nom[50];
+    char difficulte[20];
+} JournalRecord;
+
+static const ScoreStore* store = NULL;
+static void* readConnection = NULL;  // Thread principal
+static void* writeConnection = NULL; // Thread d'écriture
+
+static pthread_t writerThread;
+static bool writerStarted = false;
+static bool writerStopping = false;
+static pthread_mutex_t queueMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queueCondition = PTHREAD_COND_INITIALIZER;
+static Score* pendingScores = NULL; // File des scores pas encore écrits, plus ancien en tête
+static int pendingCount = 0;
+static int pendingCapacity = 0;
+static FILE* journal = NULL;
+static bool ranksLoaded = false; // Lu et écrit par le thread d'écriture seulement
+
+typedef struct {
+    char difficulte[20];
+    int time;
+    int count;
+} RankRow;
+
+static RankRow* rankRows = NULL;
+static int rankRowCount = 0;
+static int rankRowCapacity = 0;
+static bool rankRowsFailed = false;
+
+static void appendJournal(JournalType type, const Score* score, int value) {
+    if (!journal) return;
+    JournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.value = value;
+    if (score) {
+        snprintf(record.nom, sizeof(record.nom), "%s", score->nom);
+        snprintf(record.difficulte, sizeof(record.difficulte), "%s", score->difficulte);
+    }
+    fwrite(&record, sizeof(record), 1, journal);
+    fflush(journal); // Survit à un arrêt du jeu ; fsync fait par le thread d'écriture
+}
+
+// Appelé avec queueMutex tenu
+static bool pushPending(const Score* score) {
+    if (pendingCount == pendingCapacity) {
+        int capacity = pendingCapacity ? pendingCapacity * 2 : 16;
+        Score* grown = realloc(pendingScores, capacity * sizeof(Score));
+        if (!grown) {
+            printf("Memoire insuffisante, score perdu : %s\n", score->nom);
+            return false;
+        }
+        pendingScores = grown;
+        pendingCapacity = capacity;
+    }
+    pendingScores[pendingCount++] = *score;
+    return true;
+}
+
+// Relit le journal, garde les scores jamais écrits puis le réécrit compacté
+static void replayJournal() {
+    FILE* previous = fopen(SCORE_JOURNAL_PATH, "rb");
+    if (previous) {
+        Score* scores = NULL;
+        int scoreCount = 0, scoreCapacity = 0, flushedCount = 0;
+        JournalRecord record;
+        // Un enregistrement incomplet en fin de fichier (arrêt en pleine écriture) est ignoré
+        while (fread(&record, sizeof(record), 1, previous) == 1) {
+            if (record.type == JOURNAL_FLUSHED) {
+                flushedCount += record.value;
+            } else if (record.type == JOURNAL_SCORE) {
+                if (scoreCount == scoreCapacity) {
+                    scoreCapacity = scoreCapacity ? scoreCapacity * 2 : 16;
+                    Score* grown = realloc(scores, scoreCapacity * sizeof(Score));
+                    if (!grown) break;
+                    scores = grown;
+                }
+                Score* score = &scores[scoreCount++];
+                memset(score, 0, sizeof(Score));
+                memcpy(score->nom, record.nom, sizeof(score->nom) - 1);
+                memcpy(score->difficulte, record.difficulte, sizeof(score->difficulte) - 1);
+                score->time = record.value;
+            }
+        }
+        fclose(previous);
+        for (int i = flushedCount; i < scoreCount; i++) {
+            if (pushPending(&scores[i])) addRankScores(scores[i].difficulte, scores[i].time, 1);
+        }
+        free(scores);
+    }
+
+    const char* compactedPath = SCORE_JOURNAL_PATH ".tmp";
+    journal = fopen(compactedPath, "wb");
+    if (!journal) {
+        printf("Impossible d'ouvrir le journal des scores %s\n", SCORE_JOURNAL_PATH);
+        return;
+    }
+    for (int i = 0; i < pendingCount; i++) {
+        appendJournal(JOURNAL_SCORE, &pendingScores[i], pendingScores[i].time);
+    }
+    fsync(fileno(journal));
+    fclose(journal);
+    rename(compactedPath, SCORE_JOURNAL_PATH);
+    journal = fopen(SCORE_JOURNAL_PATH, "ab");
+    if (pendingCount > 0) printf("Scores a rejouer depuis le journal : %d\n", pendingCount);
+}
+
+static void collectRankRow(const char* difficulte, int time, int count) {
+    if (rankRowCount == rankRowCapacity) {
+        int capacity = rankRowCapacity ? rankRowCapacity * 2 : 256;
+        RankRow* grown = realloc(rankRows, capacity * sizeof(RankRow));
+        if (!grown) {
+            rankRowsFailed = true;
+            return;
+        }
+        rankRows = grown;
+        rankRowCapacity = capacity;
+    }
+    RankRow* row = &rankRows[rankRowCount++];
+    snprintf(row->difficulte, sizeof(row->difficulte), "%s", difficulte);
+    row->time = time;
+    row->count = count;
+}
+
+// Doit précéder le premier INSERT de la session : les scores soumis pendant la
+// session sont comptés à leur soumission, pas une seconde fois ici. Les lignes
+// ne sont ajoutées qu'une fois la lecture complète, pour pouvoir réessayer.
+static bool loadRanks() {
+    if (!writeConnection) writeConnection = store->open();
+    if (!writeConnection) return false;
+    rankRowCount = 0;
+    rankRowsFailed = false;
+    bool loaded = store->histogram(writeConnection, collectRankRow) && !rankRowsFailed;
+    int total = 0;
+    for (int i = 0; loaded && i < rankRowCount; i++) {
+        addRankScores(rankRows[i].difficulte, rankRows[i].time, rankRows[i].count);
+        total += rankRows[i].count;
+    }
+    free(rankRows);
+    rankRows = NULL;
+    rankRowCapacity = 0;
+    if (loaded) {
+        setRankReady(true);
+        printf("Classements charges : %d scores\n", total);
+    }
+    return loaded;
+}
+
+static void* writerMain(void* unused) {
+    (void)unused;
+    ranksLoaded = loadRanks();
+    Score batch[SCORE_BATCH_SIZE];
+    pthread_mutex_lock(&queueMutex);
+    for (;;) {
+        while (pendingCount == 0 && !writerStopping) {
+            pthread_cond_wait(&queueCondition, &queueMutex);
+        }
+        if (pendingCount == 0) break;
+        int count = pendingCount < SCORE_BATCH_SIZE ? pendingCount : SCORE_BATCH_SIZE;
+        memcpy(batch, pendingScores, count * sizeof(Score));
+        // Les enregistrements sont déjà vidés par appendJournal ; la synchronisation,
+        // lente, se fait sans le verrou pour ne pas bloquer submitScore. Le journal
+        // n'est fermé qu'après la fin de ce thread : le descripteur reste valide.
+        int journalFd = journal ? fileno(journal) : -1;
+        pthread_mutex_unlock(&queueMutex);
+        if (journalFd >= 0) fdatasync(journalFd);
+
+        if (!ranksLoaded) ranksLoaded = loadRanks();
+        bool written = ranksLoaded && store->insert(writeConnection, batch, count);
+
+        pthread_mutex_lock(&queueMutex);
+        if (written) {
+            printf("Scores inseres : %d\n", count);
+            pendingCount -= count;
+            memmove(pendingScores, pendingScores + count, pendingCount * sizeof(Score));
+            appendJournal(JOURNAL_FLUSHED, NULL, count);
+            if (pendingCount == 0 && journal) {
+                // Tout est écrit : le journal repart de zéro
+                fflush(journal);
+                if (ftruncate(fileno(journal), 0) == 0) rewind(journal);
+            }
+        } else if (writerStopping) {
+            break; // Les scores restants sont rejoués au prochain lancement
+        } else {
+            // Base absente : nouvel essai plus tard, ou dès l'arrêt du jeu
+            store->close(writeConnection);
+            writeConnection = NULL;
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += SCORE_RETRY_DELAY;
+            pthread_cond_timedwait(&queueCondition, &queueMutex, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&queueMutex);
+    store->close(writeConnection);
+    writeConnection = NULL;
+    if (store->threadEnd) store->threadEnd();
+    return NULL;
+}
+
+bool openScoreStore(const ScoreStore* selected) {
+    store = selected;
+    // Connexion de lecture d'abord : la bibliothèque est initialisée avant le thread
+    readConnection = store->open();
+    replayJournal();
+    writerStopping = false;
+    writerStarted = pthread_create(&writerThread, NULL, writerMain, NULL) == 0;
+    if (!writerStarted) printf("Impossible de demarrer le thread d'ecriture des scores\n");
+    return readConnection != NULL;
+}
+
+// Tente d'écrire ce qui reste en file ; le journal garde le reste
+void closeScoreStore() {
+    if (writerStarted) {
+        pthread_mutex_lock(&queueMutex);
+        writerStopping = true;
+        pthread_cond_signal(&queueCondition);
+        pthread_mutex_unlock(&queueMutex);
+        pthread_join(writerThread, NULL);
+        writerStarted = false;
+    }
+    if (pendingCount > 0) printf("Scores en attente gardes dans le journal : %d\n", pendingCount);
+    if (journal) fclose(journal);
+    journal = NULL;
+    free(pendingScores);
+    pendingScores = NULL;
+    pendingCount = 0;
+    pendingCapacity = 0;
+    if (store) store->close(readConnection);
+    readConnection = NULL;
+    cleanupRanks();
+}
+
+// Retourne immédiatement : le score est journalisé puis écrit en arrière-plan
+void submitScore(const char* nom, int time, const char* difficulte) {
+    Score score;
+    memset(&score, 0, sizeof(score));
+    snprintf(score.nom, sizeof(score.nom), "%s", nom);
+    snprintf(score.difficulte, sizeof(score.difficulte), "%s", difficulte);
+    score.time = time;
+
+    pthread_mutex_lock(&queueMutex);
+    // Le journal suit exactement l'ordre de la file
+    if (pushPending(&score)) appendJournal(JOURNAL_SCORE, &score, time);
+    pthread_cond_signal(&queueCondition);
+    pthread_mutex_unlock(&queueMutex);
+    addLeaderboardScore(&score); // Visible au classement sans attendre l'écriture
+    addRankScores(difficulte, time, 1);
+    printf("Score en file : %s - %d s - %s\n", nom, time, difficulte);
+}
+
+int getPendingScoreCount() {
+    pthread_mutex_lock(&queueMutex);
+    int count = pendingCount;
+    pthread_mutex_unlock(&queueMutex);
+    return count;
+}
+
+// Renvoie le nombre de scores trouvés ; le reste du tableau est vidé.
+// Servis depuis le classement en mémoire tant qu'il n'a pas expiré.
+int getTopScores(const char* difficulte, Score* scores, int count) {
+    Leaderboard* board = getLeaderboard(difficulte);
+    Score loaded[LEADERBOARD_SIZE];
+    const Score* source = loaded;
+    int found;
+    if (board && isLeaderboardFresh(board)) {
+        source = board->scores;
+        found = board->count;
+    } else {
+        if (!readConnection) readConnection = store->open();
+        found = readConnection ? store->page(readConnection, difficulte, SCORE_CURSOR_START, loaded, LEADERBOARD_SIZE) : -1;
+        if (found >= 0 && board) fillLeaderboard(board, loaded, found);
+        if (found < 0 && board && board->loaded) {
+            // Base injoignable : l'ancien classement reste affiché
+            source = board->scores;
+            found = board->count;
+        }
+        if (found < 0) found = 0;
+    }
+    if (found > count) found = count;
+    memcpy(scores, source, found * sizeof(Score));
+    memset(&scores[found], 0, (count - found) * sizeof(Score));
+    return found;
+}
+
+// Pages suivantes du classement, lues directement dans la base
+int getScorePage(const char* difficulte, ScoreCursor after, Score* scores, int count) {
+    if (after.time == SCORE_CURSOR_START.time && after.id == SCORE_CURSOR_START.id) {
+        return getTopScores(difficulte, scores, count);
+    }
+    if (!readConnection) readConnection = store->open();
+    int found = readConnection ? store->page(readConnection, difficulte, after, scores, count) : -1;
+    if (found < 0) found = 0;
+    memset(&scores[found], 0, (count - found) * sizeof(Score));
+    return found;
+}
+
+// Un score local pas encore écrit n'a pas d'id : la page suivante reprend
+// alors à son temps, quitte à répéter les scores à égalité
+ScoreCursor getScoreCursor(const Score* last) {
+    ScoreCursor cursor = {last->time, last->id != 0 ? last->id : INT_MAX};
+    return cursor;
+}
+
+// Lit une ligne « Nom,Time,Difficulte ». Le nom peut contenir des virgules :
+// les deux derniers champs sont pris depuis la fin. Une ligne d'en-tête ou
+// mal formée est ignorée.
+static bool parseScoreLine(char* line, Score* score) {
+    line[strcspn(line, "\r\n")] = '\0';
+    char* difficultySeparator = strrchr(line, ',');
+    if (!difficultySeparator) return false;
+    *difficultySeparator = '\0';
+    char* timeSeparator = strrchr(line, ',');
+    if (!timeSeparator) return false;
+    *timeSeparator = '\0';
+    char* end;
+    long time = strtol(timeSeparator + 1, &end, 10);
+    if (end == timeSeparator + 1 || *end != '\0' || time < 0 || time > INT_MAX) return false;
+    memset(score, 0, sizeof(Score));
+    snprintf(score->nom, sizeof(score->nom), "%s", line);
+    snprintf(score->difficulte, sizeof(score->difficulte), "%s", difficultySeparator + 1);
+    score->time = (int)time;
+    return score->nom[0] != '\0' && score->difficulte[0] != '\0';
+}
+
+// Import d'un historique CSV hors partie, par transactions de SCORE_IMPORT_BATCH
+// lignes. Renvoie le nombre de scores importés, -1 si rien n'a pu être écrit.
+int importScores(const ScoreStore* selected, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("Impossible de lire %s\n", path);
+        return -1;
+    }
+    void* connection = selected->open();
+    Score* batch = malloc(SCORE_IMPORT_BATCH * sizeof(Score));
+    if (!connection || !batch) {
+        fclose(file);
+        free(batch);
+        selected->close(connection);
+        return -1;
+    }
+    char line[256];
+    int count = 0, imported = 0, skipped = 0;
+    bool failed = false;
+    while (!failed && fgets(line, sizeof(line), file)) {
+        // Ligne plus longue que le tampon : sa fin ne doit pas passer pour un score
+        if (!strchr(line, '\n') && !feof(file)) {
+            int c = fgetc(file);
+            if (c != '\n' && c != EOF) {
+                while ((c = fgetc(file)) != '\n' && c != EOF) {}
+                skipped++;
+                continue;
+            }
+        }
+        if (!parseScoreLine(line, &batch[count])) {
+            skipped++;
+            continue;
+        }
+        if (++count == SCORE_IMPORT_BATCH) {
+            failed = !selected->insert(connection, batch, count);
+            if (!failed) imported += count;
+            count = 0;
+        }
+    }
+    if (!failed && count > 0) {
+        failed = !selected->insert(connection, batch, count);
+        if (!failed) imported += count;
+    }
+    printf("Scores importes : %d, lignes ignorees : %d%s\n", imported, skipped, failed ? " (arret sur erreur)" : "");
+    free(batch);
+    fclose(file);
+    selected->close(connection);
+    return imported == 0 && failed ? -1 : imported;
+}
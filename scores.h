@@ -0,0 +1,30 @@
+#ifndef SCORES_H
+#define SCORES_H
+
+// File des scores devant la base choisie (voir scorestore.h). Les scores
+// soumis sont d'abord ajoutés à un journal local, puis écrits par un thread
+// dédié, par lots : la fin de partie n'attend jamais la base, et un score non
+// écrit est rejoué au lancement suivant. Les lectures restent sur le thread
+// principal, avec leur propre connexion.
+
+#include <stdbool.h>
+#include "scorestore.h"
+#include "leaderboard.h"
+#include "rank.h"
+
+#define TOP_SCORE_COUNT LEADERBOARD_SIZE
+#define SCORE_JOURNAL_PATH "scores.journal"
+#define SCORE_BATCH_SIZE 32     // Scores par transaction
+#define SCORE_RETRY_DELAY 5     // Secondes entre deux essais quand la base est absente
+#define SCORE_IMPORT_BATCH 100000 // Lignes par transaction lors d'un import CSV (8 Mo)
+
+bool openScoreStore(const ScoreStore* store);
+void closeScoreStore();
+void submitScore(const char* nom, int time, const char* difficulte);
+int getPendingScoreCount();
+int getTopScores(const char* difficulte, Score* scores, int count);
+int getScorePage(const char* difficulte, ScoreCursor after, Score* scores, int count);
+ScoreCursor getScoreCursor(const Score* last);
+int importScores(const ScoreStore* store, const char* path);
+
+#endif
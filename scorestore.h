@@ -0,0 +1,47 @@
+#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+// Interface commune aux bases de scores, choisie au lancement. Chaque thread
+// ouvre sa propre connexion : le thread principal pour les lectures, le
+// thread d'écriture de scores.c pour les INSERT.
+//
+// Chaque base gère son schéma : table schema_version et migrations appliquées
+// à l'ouverture. L'index (Difficulte, Time DESC, Id DESC) sert toutes les
+// lectures, paginées par curseur (dernier temps et id vus) plutôt que par
+// OFFSET : une page coûte le même prix quelle que soit sa position.
+
+#include <limits.h>
+#include <stdbool.h>
+
+typedef struct {
+    int id;
+    char nom[50];
+    int time;
+    char difficulte[20];  // Nouveau champ pour la difficulté
+} Score;
+
+// Position dans un classement : les pages suivantes commencent strictement après
+typedef struct {
+    int time;
+    int id;
+} ScoreCursor;
+
+#define SCORE_CURSOR_START ((ScoreCursor){INT_MAX, INT_MAX})
+
+typedef struct {
+    const char* name;
+    void* (*open)();              // NULL si la base est inaccessible
+    void (*close)(void* connection);
+    // Tout le lot ou rien, en une seule transaction
+    bool (*insert)(void* connection, const Score* scores, int count);
+    // Scores d'une difficulté classés après le curseur, -1 en cas d'erreur
+    int (*page)(void* connection, const char* difficulte, ScoreCursor after, Score* scores, int count);
+    // Nombre de scores par difficulté et par temps, en un seul parcours de l'index
+    bool (*histogram)(void* connection, void (*row)(const char* difficulte, int time, int count));
+    void (*threadEnd)();          // Fin d'un thread qui a utilisé la base, peut être NULL
+} ScoreStore;
+
+extern const ScoreStore mysqlScoreStore;
+extern const ScoreStore sqliteScoreStore;
+
+#endif
@@ -0,0 +1,237 @@
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Générateur splitmix64 : rapide, sans état global, reproductible partout
+void seedRandom(Simulation* sim, uint64_t seed) {
+    sim->rngState = seed;
+}
+
+uint32_t nextRandom(Simulation* sim) {
+    uint64_t z = (sim->rngState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+void getDifficultyParams(Difficulty difficulty, int* ballCount, int* ballSpeed) {
+    switch (difficulty) {
+        case DIFFICULTY_MEDIUM:
+            *ballCount = MEDIUM_BALLS;
+            *ballSpeed = MEDIUM_SPEED;
+            break;
+        case DIFFICULTY_HARD:
+            *ballCount = HARD_BALLS;
+            *ballSpeed = HARD_SPEED;
+            break;
+        default:
+            *ballCount = EASY_BALLS;
+            *ballSpeed = EASY_SPEED;
+            break;
+    }
+}
+
+bool simInit(Simulation* sim, int ballCount, int ballSpeed, uint64_t seed) {
+    memset(sim, 0, sizeof(Simulation));
+    sim->ballCount = ballCount;
+    sim->ballSpeed = ballSpeed;
+    if (!allocBalls(&sim->balls, ballCount)) {
+        return false;
+    }
+    sim->player.w = PLAYER_SIZE;
+    sim->player.h = PLAYER_SIZE;
+    sim->player.x = WORLD_WIDTH / 2 - sim->player.w / 2;
+    sim->player.y = WORLD_HEIGHT / 2 - sim->player.h / 2;
+    sim->prevPlayerX = sim->player.x;
+    sim->prevPlayerY = sim->player.y;
+    seedRandom(sim, seed);
+    initBalls(sim);
+    return true;
+}
+
+bool simInitDifficulty(Simulation* sim, Difficulty difficulty, uint64_t seed) {
+    int ballCount, ballSpeed;
+    getDifficultyParams(difficulty, &ballCount, &ballSpeed);
+    if (!simInit(sim, ballCount, ballSpeed, seed)) return false;
+    sim->difficulty = difficulty;
+    return true;
+}
+
+void simFree(Simulation* sim) {
+    if (sim->grid) {
+        freeGrid(sim->grid);
+        free(sim->grid);
+        sim->grid = NULL;
+    }
+    freeBalls(&sim->balls);
+    sim->ballCount = 0;
+}
+
+// Active les chocs entre balles ; à appeler juste après simInit
+bool enableBallCollisions(Simulation* sim) {
+    if (sim->grid) return true;
+    sim->grid = malloc(sizeof(BallGrid));
+    if (!sim->grid || !initGrid(sim->grid, &sim->balls)) {
+        printf("Impossible d'activer les collisions entre balles\n");
+        free(sim->grid);
+        sim->grid = NULL;
+        return false;
+    }
+    sim->ballCollisions = true;
+    return true;
+}
+
+void initBalls(Simulation* sim) {
+    BallArrays* balls = &sim->balls;
+    int speed = sim->ballSpeed;
+    for (int i = 0; i < sim->ballCount; i++) {
+        int x = 0, y = 0, dx = 0, dy = 0;
+        // Choisir aléatoirement un des 4 côtés (0: haut, 1: droite, 2: bas, 3: gauche)
+        int side = nextRandom(sim) % 4;
+        
+        switch(side) {
+            case 0: // Haut
+                x = nextRandom(sim) % (WORLD_WIDTH - BALL_RADIUS * 2) + BALL_RADIUS;
+                y = BALL_RADIUS;
+                dx = (nextRandom(sim) % 2 == 0) ? speed : -speed;
+                dy = speed;
+                break;
+            case 1: // Droite
+                x = WORLD_WIDTH - BALL_RADIUS;
+                y = nextRandom(sim) % (WORLD_HEIGHT - BALL_RADIUS * 2) + BALL_RADIUS;
+                dx = -speed;
+                dy = (nextRandom(sim) % 2 == 0) ? speed : -speed;
+                break;
+            case 2: // Bas
+                x = nextRandom(sim) % (WORLD_WIDTH - BALL_RADIUS * 2) + BALL_RADIUS;
+                y = WORLD_HEIGHT - BALL_RADIUS;
+                dx = (nextRandom(sim) % 2 == 0) ? speed : -speed;
+                dy = -speed;
+                break;
+            case 3: // Gauche
+                x = BALL_RADIUS;
+                y = nextRandom(sim) % (WORLD_HEIGHT - BALL_RADIUS * 2) + BALL_RADIUS;
+                dx = speed;
+                dy = (nextRandom(sim) % 2 == 0) ? speed : -speed;
+                break;
+        }
+        balls->x[i] = balls->prevX[i] = x;
+        balls->y[i] = balls->prevY[i] = y;
+        balls->dx[i] = dx;
+        balls->dy[i] = dy;
+    }
+}
+
+static bool useJobPool(const Simulation* sim) {
+    return getJobThreadCount() > 1 && sim->ballCount >= PARALLEL_MIN_BALLS;
+}
+
+static void moveBallChunk(void* context, int begin, int end, int chunk) {
+    (void)chunk;
+    Simulation* sim = context;
+    moveBallRange(&sim->balls, begin, end, sim->ballCollisions);
+}
+
+void moveBalls(Simulation* sim) {
+    if (useJobPool(sim)) {
+        parallelFor(sim->ballCount, BALL_CHUNK_SIZE, moveBallChunk, sim);
+    } else {
+        moveBallRange(&sim->balls, 0, sim->ballCount, sim->ballCollisions);
+    }
+}
+
+static void gridCellChunk(void* context, int begin, int end, int chunk) {
+    (void)chunk;
+    Simulation* sim = context;
+    computeGridCellRange(sim->grid, &sim->balls, begin, end);
+}
+
+typedef struct {
+    Simulation* sim;
+    int phase;
+} PhaseJob;
+
+static void phaseChunk(void* context, int begin, int end, int chunk) {
+    (void)chunk;
+    PhaseJob* job = context;
+    resolvePhaseRange(job->sim->grid, &job->sim->balls, job->phase, begin, end);
+}
+
+// Mêmes étapes que resolveBallCollisions : seul le calcul des cases et les
+// cases d'une même phase sont réparties, le chaînage reste séquentiel
+static void resolveBallCollisionsParallel(Simulation* sim) {
+    parallelFor(sim->ballCount, BALL_CHUNK_SIZE, gridCellChunk, sim);
+    relinkGrid(sim->grid);
+    for (int phase = 0; phase < GRID_PHASES; phase++) {
+        PhaseJob job = {sim, phase};
+        parallelFor(sim->grid->phaseCellCount[phase], CELL_CHUNK_SIZE, phaseChunk, &job);
+    }
+}
+
+typedef struct {
+    Simulation* sim;
+    int hits[MAX_JOB_CHUNKS];
+} CollisionJob;
+
+static void collisionChunk(void* context, int begin, int end, int chunk) {
+    CollisionJob* job = context;
+    job->hits[chunk] = findCollisionInRange(&job->sim->balls, job->sim->player, begin, end);
+}
+
+// Réduction dans l'ordre des morceaux : même balle trouvée qu'en séquentiel
+static int findPlayerCollision(Simulation* sim) {
+    if (!useJobPool(sim)) {
+        return findCollisionInRange(&sim->balls, sim->player, 0, sim->ballCount);
+    }
+    CollisionJob job;
+    job.sim = sim;
+    parallelFor(sim->ballCount, BALL_CHUNK_SIZE, collisionChunk, &job);
+    int chunkCount = getJobChunkCount(sim->ballCount, BALL_CHUNK_SIZE);
+    for (int chunk = 0; chunk < chunkCount; chunk++) {
+        if (job.hits[chunk] >= 0) return job.hits[chunk];
+    }
+    return -1;
+}
+
+void movePlayer(Simulation* sim, SimInput input) {
+    SimRect* player = &sim->player;
+    sim->prevPlayerX = player->x;
+    sim->prevPlayerY = player->y;
+    if ((input & INPUT_UP) && player->y > 0) player->y -= PLAYER_SPEED;
+    if ((input & INPUT_DOWN) && player->y + player->h < WORLD_HEIGHT) player->y += PLAYER_SPEED;
+    if ((input & INPUT_LEFT) && player->x > 0) player->x -= PLAYER_SPEED;
+    if ((input & INPUT_RIGHT) && player->x + player->w < WORLD_WIDTH) player->x += PLAYER_SPEED;
+}
+
+// Un pas de simulation : renvoie true si le joueur a été touché
+bool simStep(Simulation* sim, SimInput input) {
+    if (sim->over) return true;
+    sim->tick++;
+    movePlayer(sim, input);
+    moveBalls(sim);
+    if (sim->ballCollisions) {
+        if (useJobPool(sim)) {
+            resolveBallCollisionsParallel(sim);
+        } else {
+            resolveBallCollisions(sim->grid, &sim->balls);
+        }
+    }
+    if (findPlayerCollision(sim) >= 0) {
+        sim->over = true;
+    }
+    return sim->over;
+}
+
+// Rejoue une suite d'entrées (la dernière est répétée au-delà) jusqu'à la
+// collision ou maxTicks ; renvoie le nombre de pas simulés
+uint32_t simRun(Simulation* sim, const SimInput* inputs, uint32_t inputCount, uint32_t maxTicks) {
+    while (!sim->over && sim->tick < maxTicks) {
+        SimInput input = 0;
+        if (inputCount > 0) {
+            input = inputs[sim->tick < inputCount ? sim->tick : inputCount - 1];
+        }
+        simStep(sim, input);
+    }
+    return sim->tick;
+}
@@ -0,0 +1,69 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Cœur de simulation sans SDL : balles, joueur et collisions.
+// Déterministe pour une graine et une suite d'entrées données.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "physics.h"
+#include "grid.h"
+#include "jobs.h"
+
+#define PLAYER_SPEED 5
+#define PLAYER_SIZE 50
+#define EASY_BALLS 3
+#define MEDIUM_BALLS 6
+#define HARD_BALLS 9
+#define EASY_SPEED 3
+#define MEDIUM_SPEED 4
+#define HARD_SPEED 5
+
+// En dessous, le découpage coûte plus qu'il ne rapporte
+#define PARALLEL_MIN_BALLS 4096
+#define BALL_CHUNK_SIZE 1024 // Multiple de 8 : les morceaux restent alignés pour l'AVX2
+#define CELL_CHUNK_SIZE 2
+
+// Entrées d'un pas de simulation (flèches enfoncées)
+#define INPUT_UP 0x01
+#define INPUT_DOWN 0x02
+#define INPUT_LEFT 0x04
+#define INPUT_RIGHT 0x08
+
+typedef uint8_t SimInput;
+
+typedef enum {
+    DIFFICULTY_EASY,
+    DIFFICULTY_MEDIUM,
+    DIFFICULTY_HARD,
+    DIFFICULTY_COUNT
+} Difficulty;
+
+typedef struct {
+    uint64_t rngState;
+    Difficulty difficulty;
+    int ballCount;
+    int ballSpeed;
+    BallArrays balls;
+    SimRect player;
+    int prevPlayerX, prevPlayerY;
+    uint32_t tick;   // Nombre de pas simulés
+    bool over;       // Collision survenue
+    bool ballCollisions; // Chocs élastiques entre balles (optionnel)
+    BallGrid* grid;
+} Simulation;
+
+void seedRandom(Simulation* sim, uint64_t seed);
+uint32_t nextRandom(Simulation* sim);
+void getDifficultyParams(Difficulty difficulty, int* ballCount, int* ballSpeed);
+bool simInit(Simulation* sim, int ballCount, int ballSpeed, uint64_t seed);
+bool simInitDifficulty(Simulation* sim, Difficulty difficulty, uint64_t seed);
+void simFree(Simulation* sim);
+bool enableBallCollisions(Simulation* sim);
+void initBalls(Simulation* sim);
+void moveBalls(Simulation* sim);
+void movePlayer(Simulation* sim, SimInput input);
+bool simStep(Simulation* sim, SimInput input);
+uint32_t simRun(Simulation* sim, const SimInput* inputs, uint32_t inputCount, uint32_t maxTicks);
+
+#endif
@@ -0,0 +1,78 @@
+// Vérification hors ligne de la physique, sans SDL : avec les chocs entre
+// balles activés, aucune balle ne doit sortir du monde, et chaque noyau
+// (scalaire, SSE2, AVX2) doit donner exactement les mêmes positions.
+// Utilisation : ./valocheck (code de retour non nul en cas d'échec)
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+
+#define CHECK_SEEDS 20
+#define CHECK_TICKS 3600 // Une minute de jeu
+#define CHECK_SPEED HARD_SPEED
+#define CHECK_MAX_BALLS 500
+
+static const int checkBallCounts[] = {HARD_BALLS, 100, CHECK_MAX_BALLS};
+
+// Première balle hors de [BALL_RADIUS, WORLD - BALL_RADIUS], ou -1
+static int findEscapedBall(const BallArrays* balls) {
+    for (int i = 0; i < balls->count; i++) {
+        if (balls->x[i] < BALL_RADIUS || balls->x[i] > WORLD_WIDTH - BALL_RADIUS ||
+            balls->y[i] < BALL_RADIUS || balls->y[i] > WORLD_HEIGHT - BALL_RADIUS) return i;
+    }
+    return -1;
+}
+
+// Même enchaînement que simStep sans le joueur : la partie ne s'arrête pas
+// à la première collision. Remplit final avec les positions du dernier pas.
+static bool runWorld(int ballCount, uint64_t seed, float* final) {
+    Simulation sim;
+    if (!simInit(&sim, ballCount, CHECK_SPEED, seed)) return false;
+    if (!enableBallCollisions(&sim)) {
+        simFree(&sim);
+        return false;
+    }
+    bool inside = true;
+    for (uint32_t tick = 1; tick <= CHECK_TICKS && inside; tick++) {
+        moveBalls(&sim);
+        resolveBallCollisions(sim.grid, &sim.balls);
+        int escaped = findEscapedBall(&sim.balls);
+        if (escaped >= 0) {
+            printf("ECHEC %s : graine %llu, %d balles, balle %d hors du monde au pas %u (%.1f, %.1f)\n",
+                   getPhysicsBackendName(), (unsigned long long)seed, ballCount, escaped, tick,
+                   sim.balls.x[escaped], sim.balls.y[escaped]);
+            inside = false;
+        }
+    }
+    memcpy(final, sim.balls.x, ballCount * sizeof(float));
+    memcpy(final + ballCount, sim.balls.y, ballCount * sizeof(float));
+    simFree(&sim);
+    return inside;
+}
+
+int main() {
+    PhysicsBackend best = detectPhysicsBackend();
+    int failures = 0, runs = 0;
+    printf("Verification de la physique (noyaux jusqu'a %s)\n", getPhysicsBackendName());
+    for (size_t c = 0; c < sizeof(checkBallCounts) / sizeof(checkBallCounts[0]); c++) {
+        int ballCount = checkBallCounts[c];
+        static float reference[2 * CHECK_MAX_BALLS];
+        static float positions[2 * CHECK_MAX_BALLS];
+        for (uint64_t seed = 1; seed <= CHECK_SEEDS; seed++) {
+            for (int backend = PHYSICS_SCALAR; backend <= (int)best; backend++) {
+                setPhysicsBackend((PhysicsBackend)backend);
+                float* final = backend == PHYSICS_SCALAR ? reference : positions;
+                runs++;
+                if (!runWorld(ballCount, seed, final)) {
+                    failures++;
+                } else if (backend != PHYSICS_SCALAR && memcmp(reference, positions, 2 * ballCount * sizeof(float)) != 0) {
+                    printf("ECHEC %s : graine %llu, %d balles, positions differentes du scalaire\n",
+                           getPhysicsBackendName(), (unsigned long long)seed, ballCount);
+                    failures++;
+                }
+            }
+        }
+    }
+    setPhysicsBackend(best);
+    printf("%d essai(s), %d echec(s)\n", runs, failures);
+    return failures > 0 ? 1 : 0;
+}
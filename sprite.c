@@ -0,0 +1,124 @@
+#include "sprite.h"
+#include "profile.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INITIAL_SPRITE_CAPACITY 256
+
+static SDL_Renderer* spriteRenderer = NULL;
+static SDL_Texture* batchTexture = NULL;
+static float batchTextureWidth = 1.0f;
+static float batchTextureHeight = 1.0f;
+static SDL_Vertex* vertices = NULL;
+static int* indices = NULL;   // Deux triangles par quad, partagés par tous les lots
+static int capacity = 0;      // En nombre de sprites
+static int spriteCount = 0;
+static int drawCalls = 0;
+
+static bool growSprites(int newCapacity) {
+    SDL_Vertex* newVertices = realloc(vertices, newCapacity * 4 * sizeof(SDL_Vertex));
+    if (!newVertices) return false;
+    vertices = newVertices;
+    int* newIndices = realloc(indices, newCapacity * 6 * sizeof(int));
+    if (!newIndices) return false;
+    indices = newIndices;
+    for (int i = capacity; i < newCapacity; i++) {
+        indices[i * 6 + 0] = i * 4 + 0;
+        indices[i * 6 + 1] = i * 4 + 1;
+        indices[i * 6 + 2] = i * 4 + 2;
+        indices[i * 6 + 3] = i * 4 + 0;
+        indices[i * 6 + 4] = i * 4 + 2;
+        indices[i * 6 + 5] = i * 4 + 3;
+    }
+    capacity = newCapacity;
+    return true;
+}
+
+bool initSprites(SDL_Renderer* renderer) {
+    spriteRenderer = renderer;
+    if (!growSprites(INITIAL_SPRITE_CAPACITY)) {
+        printf("Erreur d'allocation memoire pour les sprites\n");
+        return false;
+    }
+    return true;
+}
+
+void cleanupSprites() {
+    free(vertices);
+    free(indices);
+    vertices = NULL;
+    indices = NULL;
+    capacity = 0;
+    spriteCount = 0;
+    batchTexture = NULL;
+}
+
+// Envoie le lot en cours ; à appeler avant tout autre dessin
+void flushSprites() {
+    PROFILE_SCOPE("flushSprites");
+    if (spriteCount > 0) {
+        SDL_RenderGeometry(spriteRenderer, batchTexture, vertices, spriteCount * 4, indices, spriteCount * 6);
+        drawCalls++;
+    }
+    spriteCount = 0;
+    batchTexture = NULL; // Taille relue au prochain lot, la texture a pu être détruite
+}
+
+// src en pixels de la texture (NULL : texture entière), angle en degrés
+// autour du centre de dest comme SDL_RenderCopyEx
+void drawSprite(SDL_Texture* texture, const SDL_Rect* src, SDL_FRect dest, float angle, SDL_Color color) {
+    if (!texture) return;
+    if (texture != batchTexture) {
+        flushSprites();
+        int width, height;
+        if (SDL_QueryTexture(texture, NULL, NULL, &width, &height) != 0) return;
+        batchTexture = texture;
+        batchTextureWidth = (float)width;
+        batchTextureHeight = (float)height;
+    }
+    if (spriteCount == capacity && !growSprites(capacity * 2)) {
+        flushSprites();
+        batchTexture = texture;
+    }
+
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src) {
+        u0 = src->x / batchTextureWidth;
+        v0 = src->y / batchTextureHeight;
+        u1 = (src->x + src->w) / batchTextureWidth;
+        v1 = (src->y + src->h) / batchTextureHeight;
+    }
+
+    // Coins relatifs au centre, tournés si besoin
+    float halfW = dest.w * 0.5f;
+    float halfH = dest.h * 0.5f;
+    float centerX = dest.x + halfW;
+    float centerY = dest.y + halfH;
+    float cornersX[4] = {-halfW, halfW, halfW, -halfW};
+    float cornersY[4] = {-halfH, -halfH, halfH, halfH};
+    if (angle != 0.0f) {
+        float radians = angle * (float)M_PI / 180.0f;
+        float c = cosf(radians);
+        float s = sinf(radians);
+        for (int k = 0; k < 4; k++) {
+            float x = cornersX[k];
+            cornersX[k] = x * c - cornersY[k] * s;
+            cornersY[k] = x * s + cornersY[k] * c;
+        }
+    }
+
+    SDL_Vertex* v = &vertices[spriteCount * 4];
+    v[0] = (SDL_Vertex){{centerX + cornersX[0], centerY + cornersY[0]}, color, {u0, v0}};
+    v[1] = (SDL_Vertex){{centerX + cornersX[1], centerY + cornersY[1]}, color, {u1, v0}};
+    v[2] = (SDL_Vertex){{centerX + cornersX[2], centerY + cornersY[2]}, color, {u1, v1}};
+    v[3] = (SDL_Vertex){{centerX + cornersX[3], centerY + cornersY[3]}, color, {u0, v1}};
+    spriteCount++;
+}
+
+// Nombre d'appels SDL_RenderGeometry depuis le dernier appel
+int getSpriteDrawCalls() {
+    int count = drawCalls;
+    drawCalls = 0;
+    return count;
+}
@@ -0,0 +1,18 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+// Regroupement des sprites : les instances successives d'une même texture
+// sont envoyées en un seul SDL_RenderGeometry.
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#define SPRITE_WHITE ((SDL_Color){255, 255, 255, 255})
+
+bool initSprites(SDL_Renderer* renderer);
+void cleanupSprites();
+void drawSprite(SDL_Texture* texture, const SDL_Rect* src, SDL_FRect dest, float angle, SDL_Color color);
+void flushSprites();
+int getSpriteDrawCalls();
+
+#endif
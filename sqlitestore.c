@@ -0,0 +1,172 @@
+#include "scorestore.h"
+#include <sqlite3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCORE_SQLITE_PATH "scores.db"
+#define SCORE_SQLITE_BUSY_TIMEOUT 2000 // Millisecondes d'attente si l'autre connexion écrit
+
+// Fichier local, sans serveur : pour les bornes et les machines hors ligne.
+// En mode WAL, le thread d'écriture n'empêche jamais les lectures du menu.
+typedef struct {
+    sqlite3* db;
+    sqlite3_stmt* insertStatement;
+    sqlite3_stmt* pageStatement;
+    sqlite3_stmt* histogramStatement;
+} SqliteConnection;
+
+static const char* settings =
+    "PRAGMA journal_mode = WAL;"
+    "PRAGMA synchronous = NORMAL;" // Sûr en WAL : seul le dernier commit peut être perdu
+    "CREATE TABLE IF NOT EXISTS schema_version (version INTEGER NOT NULL);";
+
+// Migration i amène le schéma de la version i à i + 1 ; ne jamais en modifier une publiée
+static const char* migrations[] = {
+    "CREATE TABLE IF NOT EXISTS Scores ("
+    "    Id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "    Nom TEXT NOT NULL,"
+    "    Time INTEGER NOT NULL,"
+    "    Difficulte TEXT NOT NULL"
+    ")",
+    "CREATE INDEX IF NOT EXISTS idx_scores_difficulte_time ON Scores (Difficulte, Time DESC, Id DESC)"
+};
+
+static const char* insertQuery = "INSERT INTO Scores (Nom, Time, Difficulte) VALUES (?, ?, ?)";
+static const char* pageQuery =
+    "SELECT Id, Nom, Time, Difficulte FROM Scores"
+    " WHERE Difficulte = ?1 AND (Time < ?2 OR (Time = ?2 AND Id < ?3))"
+    " ORDER BY Time DESC, Id DESC LIMIT ?4";
+static const char* histogramQuery = "SELECT Difficulte, Time, COUNT(*) FROM Scores GROUP BY Difficulte, Time";
+
+static void reportError(SqliteConnection* connection) {
+    printf("Erreur SQLite : %s\n", sqlite3_errmsg(connection->db));
+}
+
+static void closeSqlite(void* opened) {
+    SqliteConnection* connection = opened;
+    if (!connection) return;
+    sqlite3_finalize(connection->insertStatement);
+    sqlite3_finalize(connection->pageStatement);
+    sqlite3_finalize(connection->histogramStatement);
+    sqlite3_close(connection->db);
+    free(connection);
+}
+
+// Dans une transaction d'écriture : une autre connexion qui ouvre la base en
+// même temps attend la fin au lieu de migrer une seconde fois
+static bool migrate(SqliteConnection* connection) {
+    if (sqlite3_exec(connection->db, "BEGIN IMMEDIATE", NULL, NULL, NULL) != SQLITE_OK) return false;
+    sqlite3_stmt* statement = NULL;
+    int version = -1;
+    if (sqlite3_prepare_v2(connection->db, "SELECT COALESCE(MAX(version), 0) FROM schema_version", -1, &statement, NULL) == SQLITE_OK &&
+        sqlite3_step(statement) == SQLITE_ROW) {
+        version = sqlite3_column_int(statement, 0);
+    }
+    sqlite3_finalize(statement);
+    int latest = (int)(sizeof(migrations) / sizeof(migrations[0]));
+    bool migrated = version >= 0;
+    for (int i = version; migrated && i < latest; i++) {
+        char record[64];
+        snprintf(record, sizeof(record), "INSERT INTO schema_version VALUES (%d)", i + 1);
+        migrated = sqlite3_exec(connection->db, migrations[i], NULL, NULL, NULL) == SQLITE_OK &&
+                   sqlite3_exec(connection->db, record, NULL, NULL, NULL) == SQLITE_OK;
+    }
+    if (!migrated || sqlite3_exec(connection->db, "COMMIT", NULL, NULL, NULL) != SQLITE_OK) {
+        reportError(connection);
+        sqlite3_exec(connection->db, "ROLLBACK", NULL, NULL, NULL);
+        return false;
+    }
+    if (version < latest) printf("Schema des scores SQLite : version %d -> %d\n", version, latest);
+    return true;
+}
+
+static void* openSqlite() {
+    SqliteConnection* connection = calloc(1, sizeof(SqliteConnection));
+    if (!connection) return NULL;
+    if (sqlite3_open_v2(SCORE_SQLITE_PATH, &connection->db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK ||
+        sqlite3_busy_timeout(connection->db, SCORE_SQLITE_BUSY_TIMEOUT) != SQLITE_OK ||
+        sqlite3_exec(connection->db, settings, NULL, NULL, NULL) != SQLITE_OK) {
+        reportError(connection);
+        closeSqlite(connection);
+        return NULL;
+    }
+    if (!migrate(connection)) {
+        closeSqlite(connection);
+        return NULL;
+    }
+    if (sqlite3_prepare_v2(connection->db, insertQuery, -1, &connection->insertStatement, NULL) != SQLITE_OK ||
+        sqlite3_prepare_v2(connection->db, pageQuery, -1, &connection->pageStatement, NULL) != SQLITE_OK ||
+        sqlite3_prepare_v2(connection->db, histogramQuery, -1, &connection->histogramStatement, NULL) != SQLITE_OK) {
+        reportError(connection);
+        closeSqlite(connection);
+        return NULL;
+    }
+    return connection;
+}
+
+// Une transaction par lot : un seul fsync du WAL quelle que soit sa taille
+static bool insertSqlite(void* opened, const Score* scores, int count) {
+    SqliteConnection* connection = opened;
+    sqlite3_stmt* statement = connection->insertStatement;
+    if (sqlite3_exec(connection->db, "BEGIN IMMEDIATE", NULL, NULL, NULL) != SQLITE_OK) {
+        reportError(connection);
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        sqlite3_bind_text(statement, 1, scores[i].nom, -1, SQLITE_STATIC);
+        sqlite3_bind_int(statement, 2, scores[i].time);
+        sqlite3_bind_text(statement, 3, scores[i].difficulte, -1, SQLITE_STATIC);
+        int status = sqlite3_step(statement);
+        sqlite3_reset(statement);
+        if (status != SQLITE_DONE) {
+            reportError(connection);
+            sqlite3_exec(connection->db, "ROLLBACK", NULL, NULL, NULL);
+            return false;
+        }
+    }
+    if (sqlite3_exec(connection->db, "COMMIT", NULL, NULL, NULL) != SQLITE_OK) {
+        reportError(connection);
+        sqlite3_exec(connection->db, "ROLLBACK", NULL, NULL, NULL);
+        return false;
+    }
+    return true;
+}
+
+static int pageSqlite(void* opened, const char* difficulte, ScoreCursor after, Score* scores, int count) {
+    SqliteConnection* connection = opened;
+    sqlite3_stmt* statement = connection->pageStatement;
+    sqlite3_bind_text(statement, 1, difficulte, -1, SQLITE_STATIC);
+    sqlite3_bind_int(statement, 2, after.time);
+    sqlite3_bind_int(statement, 3, after.id);
+    sqlite3_bind_int(statement, 4, count);
+    int found = 0;
+    int status = SQLITE_DONE;
+    while (found < count && (status = sqlite3_step(statement)) == SQLITE_ROW) {
+        Score* score = &scores[found++];
+        score->id = sqlite3_column_int(statement, 0);
+        snprintf(score->nom, sizeof(score->nom), "%s", (const char*)sqlite3_column_text(statement, 1));
+        score->time = sqlite3_column_int(statement, 2);
+        snprintf(score->difficulte, sizeof(score->difficulte), "%s", (const char*)sqlite3_column_text(statement, 3));
+    }
+    if (found < count && status != SQLITE_DONE) {
+        reportError(connection);
+        found = -1;
+    }
+    sqlite3_reset(statement);
+    return found;
+}
+
+static bool histogramSqlite(void* opened, void (*row)(const char* difficulte, int time, int count)) {
+    SqliteConnection* connection = opened;
+    sqlite3_stmt* statement = connection->histogramStatement;
+    int status;
+    while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+        row((const char*)sqlite3_column_text(statement, 0), sqlite3_column_int(statement, 1), sqlite3_column_int(statement, 2));
+    }
+    if (status != SQLITE_DONE) reportError(connection);
+    sqlite3_reset(statement);
+    return status == SQLITE_DONE;
+}
+
+const ScoreStore sqliteScoreStore = {"SQLite", openSqlite, closeSqlite, insertSqlite, pageSqlite, histogramSqlite, NULL};
@@ -0,0 +1,248 @@
+#include "text.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ATLAS_WIDTH 512
+
+static SDL_Renderer* textRenderer = NULL;
+static FontAtlas fontAtlases[MAX_FONT_ATLASES];
+static int fontAtlasCount = 0;
+static int quadIndices[MAX_TEXT_LENGTH * 6]; // Indices partagés par tous les quads de texte
+
+bool initText(SDL_Renderer* renderer) {
+    textRenderer = renderer;
+    for (int i = 0; i < MAX_TEXT_LENGTH; i++) {
+        quadIndices[i * 6 + 0] = i * 4 + 0;
+        quadIndices[i * 6 + 1] = i * 4 + 1;
+        quadIndices[i * 6 + 2] = i * 4 + 2;
+        quadIndices[i * 6 + 3] = i * 4 + 0;
+        quadIndices[i * 6 + 4] = i * 4 + 2;
+        quadIndices[i * 6 + 5] = i * 4 + 3;
+    }
+    // Ouvrir et rasteriser la police par défaut dès le démarrage
+    return getDefaultFont() != NULL;
+}
+
+void cleanupText() {
+    for (int i = 0; i < fontAtlasCount; i++) {
+        if (fontAtlases[i].texture) SDL_DestroyTexture(fontAtlases[i].texture);
+        releaseResource(fontAtlases[i].fontResource);
+    }
+    fontAtlasCount = 0;
+}
+
+static bool buildFontAtlas(FontAtlas* atlas) {
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* glyphSurfaces[GLYPH_COUNT];
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+
+    // Rasteriser chaque glyphe une seule fois et calculer son emplacement
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint16 c = FIRST_GLYPH + i;
+        Glyph* glyph = &atlas->glyphs[i];
+        int minx, maxx, miny, maxy;
+        if (TTF_GlyphMetrics(atlas->font, c, &minx, &maxx, &miny, &maxy, &glyph->advance) < 0) {
+            glyph->advance = 0;
+        }
+        glyphSurfaces[i] = TTF_RenderGlyph_Blended(atlas->font, c, white);
+        if (!glyphSurfaces[i]) {
+            glyph->src = (SDL_Rect){0, 0, 0, 0};
+            continue;
+        }
+        if (penX + glyphSurfaces[i]->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        glyph->src = (SDL_Rect){penX, penY, glyphSurfaces[i]->w, glyphSurfaces[i]->h};
+        penX += glyphSurfaces[i]->w + 1;
+        if (glyphSurfaces[i]->h > rowHeight) rowHeight = glyphSurfaces[i]->h;
+    }
+
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, penY + rowHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        printf("Erreur de création de l'atlas de glyphes : %s\n", SDL_GetError());
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            if (glyphSurfaces[i]) SDL_FreeSurface(glyphSurfaces[i]);
+        }
+        return false;
+    }
+    SDL_FillRect(atlasSurface, NULL, 0);
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (!glyphSurfaces[i]) continue;
+        // Copier l'alpha du glyphe tel quel au lieu de le mélanger
+        SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(glyphSurfaces[i], NULL, atlasSurface, &atlas->glyphs[i].src);
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    atlas->texture = SDL_CreateTextureFromSurface(textRenderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!atlas->texture) {
+        printf("Erreur de création de la texture de l'atlas : %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+    atlas->height = TTF_FontHeight(atlas->font);
+    return true;
+}
+
+FontAtlas* getFontAtlas(const char* path, int size) {
+    for (int i = 0; i < fontAtlasCount; i++) {
+        if (fontAtlases[i].size == size && strcmp(fontAtlases[i].path, path) == 0) {
+            return &fontAtlases[i];
+        }
+    }
+    if (fontAtlasCount >= MAX_FONT_ATLASES || !textRenderer) {
+        printf("Impossible de créer un nouvel atlas pour %s (%d)\n", path, size);
+        return NULL;
+    }
+
+    FontAtlas* atlas = &fontAtlases[fontAtlasCount];
+    memset(atlas, 0, sizeof(FontAtlas));
+    strncpy(atlas->path, path, sizeof(atlas->path) - 1);
+    atlas->size = size;
+    atlas->fontResource = acquireFont(path, size);
+    atlas->font = getFont(atlas->fontResource);
+    if (!atlas->font) {
+        printf("Erreur de chargement de la police : %s\n", TTF_GetError());
+        return NULL;
+    }
+    if (!buildFontAtlas(atlas)) {
+        releaseResource(atlas->fontResource);
+        atlas->fontResource = NULL;
+        atlas->font = NULL;
+        return NULL;
+    }
+    fontAtlasCount++;
+    return atlas;
+}
+
+FontAtlas* getDefaultFont() {
+    return getFontAtlas(FONT_PATH, FONT_SIZE);
+}
+
+static const Glyph* findGlyph(FontAtlas* atlas, char c) {
+    if ((unsigned char)c < FIRST_GLYPH || (unsigned char)c > LAST_GLYPH) {
+        c = '?';
+    }
+    return &atlas->glyphs[(unsigned char)c - FIRST_GLYPH];
+}
+
+void measureText(FontAtlas* atlas, const char* text, int* w, int* h) {
+    int penX = 0;
+    int width = 0;
+    for (const char* p = text; *p; p++) {
+        const Glyph* glyph = findGlyph(atlas, *p);
+        if (penX + glyph->src.w > width) width = penX + glyph->src.w;
+        penX += glyph->advance;
+    }
+    if (penX > width) width = penX;
+    if (w) *w = width;
+    if (h) *h = atlas->height;
+}
+
+// Construit un quad par caractère, étiré pour remplir rect comme le faisait
+// SDL_RenderCopy avec les anciennes textures de texte
+static int buildTextVertices(FontAtlas* atlas, const char* text, SDL_Rect rect, SDL_Color color, SDL_Vertex* vertices) {
+    int textWidth, textHeight;
+    measureText(atlas, text, &textWidth, &textHeight);
+    if (textWidth == 0 || textHeight == 0) return 0;
+
+    // L'alpha est ignoré, comme avec TTF_RenderText_Solid
+    color.a = 255;
+    float scaleX = (float)rect.w / textWidth;
+    float scaleY = (float)rect.h / textHeight;
+    int textureWidth, textureHeight;
+    SDL_QueryTexture(atlas->texture, NULL, NULL, &textureWidth, &textureHeight);
+
+    int quadCount = 0;
+    int penX = 0;
+    for (const char* p = text; *p && quadCount < MAX_TEXT_LENGTH; p++) {
+        const Glyph* glyph = findGlyph(atlas, *p);
+        if (glyph->src.w > 0 && *p != ' ') {
+            float x0 = rect.x + penX * scaleX;
+            float y0 = rect.y;
+            float x1 = x0 + glyph->src.w * scaleX;
+            float y1 = y0 + glyph->src.h * scaleY;
+            float u0 = (float)glyph->src.x / textureWidth;
+            float v0 = (float)glyph->src.y / textureHeight;
+            float u1 = (float)(glyph->src.x + glyph->src.w) / textureWidth;
+            float v1 = (float)(glyph->src.y + glyph->src.h) / textureHeight;
+            SDL_Vertex* v = &vertices[quadCount * 4];
+            v[0] = (SDL_Vertex){{x0, y0}, color, {u0, v0}};
+            v[1] = (SDL_Vertex){{x1, y0}, color, {u1, v0}};
+            v[2] = (SDL_Vertex){{x1, y1}, color, {u1, v1}};
+            v[3] = (SDL_Vertex){{x0, y1}, color, {u0, v1}};
+            quadCount++;
+        }
+        penX += glyph->advance;
+    }
+    return quadCount;
+}
+
+void drawText(FontAtlas* atlas, const char* text, SDL_Rect rect, SDL_Color color) {
+    static SDL_Vertex vertices[MAX_TEXT_LENGTH * 4];
+    if (!atlas) return;
+    int quadCount = buildTextVertices(atlas, text, rect, color, vertices);
+    if (quadCount > 0) {
+        SDL_RenderGeometry(textRenderer, atlas->texture, vertices, quadCount * 4, quadIndices, quadCount * 6);
+    }
+}
+
+void drawTextAt(FontAtlas* atlas, const char* text, int x, int y, SDL_Color color) {
+    if (!atlas) return;
+    int w, h;
+    measureText(atlas, text, &w, &h);
+    SDL_Rect rect = {x, y, w, h};
+    drawText(atlas, text, rect, color);
+}
+
+void initDynamicText(DynamicText* dynamicText, FontAtlas* atlas, SDL_Rect rect, SDL_Color color) {
+    memset(dynamicText, 0, sizeof(DynamicText));
+    dynamicText->atlas = atlas;
+    dynamicText->rect = rect;
+    dynamicText->color = color;
+}
+
+void setDynamicText(DynamicText* dynamicText, const char* format, ...) {
+    char buffer[MAX_TEXT_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    // Rien à faire si le texte affiché n'a pas changé
+    if (strcmp(buffer, dynamicText->text) == 0) return;
+    strcpy(dynamicText->text, buffer);
+    if (dynamicText->atlas) {
+        dynamicText->quadCount = buildTextVertices(dynamicText->atlas, dynamicText->text, dynamicText->rect,
+                                                   dynamicText->color, dynamicText->vertices);
+    }
+}
+
+void drawDynamicText(DynamicText* dynamicText) {
+    if (!dynamicText->atlas || dynamicText->quadCount == 0) return;
+    SDL_RenderGeometry(textRenderer, dynamicText->atlas->texture, dynamicText->vertices,
+                       dynamicText->quadCount * 4, quadIndices, dynamicText->quadCount * 6);
+}
+
+// Une texture par chaîne, rendue par SDL_ttf : l'ancien chemin du texte,
+// remplacé par l'atlas de glyphes et gardé comme référence pour `make bench`
+SDL_Texture* createTextTexture(const char* text, SDL_Color color) {
+    FontAtlas* atlas = getDefaultFont();
+    if (!atlas) {
+        return NULL;
+    }
+    SDL_Surface* textSurface = TTF_RenderText_Solid(atlas->font, text, color);
+    if (!textSurface) {
+        printf("Erreur de création de la surface du texte : %s\n", TTF_GetError());
+        return NULL;
+    }
+    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(textRenderer, textSurface);
+    SDL_FreeSurface(textSurface);
+    return textTexture;
+}
@@ -0,0 +1,57 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdbool.h>
+#include "resource.h"
+
+#define FONT_PATH "KOMIKAX_.ttf"
+#define FONT_SIZE 24
+
+// Plage de caractères rasterisés dans l'atlas (ASCII imprimable)
+#define FIRST_GLYPH 32
+#define LAST_GLYPH 126
+#define GLYPH_COUNT (LAST_GLYPH - FIRST_GLYPH + 1)
+#define MAX_FONT_ATLASES 8
+#define MAX_TEXT_LENGTH 128
+
+typedef struct {
+    SDL_Rect src; // Position du glyphe dans l'atlas
+    int advance;  // Avance horizontale du stylo
+} Glyph;
+
+typedef struct {
+    char path[256];
+    int size;
+    Resource* fontResource; // Police partagée via le cache de ressources
+    TTF_Font* font;
+    SDL_Texture* texture;  // Atlas partagé par tous les textes de cette police
+    int height;
+    Glyph glyphs[GLYPH_COUNT];
+} FontAtlas;
+
+// Texte qui change peu souvent (chronomètre, nom saisi...) : les sommets ne
+// sont recalculés que lorsque la chaîne ou le rectangle changent.
+typedef struct {
+    FontAtlas* atlas;
+    char text[MAX_TEXT_LENGTH];
+    SDL_Rect rect;
+    SDL_Color color;
+    int quadCount;
+    SDL_Vertex vertices[MAX_TEXT_LENGTH * 4];
+} DynamicText;
+
+bool initText(SDL_Renderer* renderer);
+void cleanupText();
+FontAtlas* getFontAtlas(const char* path, int size);
+FontAtlas* getDefaultFont();
+void measureText(FontAtlas* atlas, const char* text, int* w, int* h);
+void drawText(FontAtlas* atlas, const char* text, SDL_Rect rect, SDL_Color color);
+void drawTextAt(FontAtlas* atlas, const char* text, int x, int y, SDL_Color color);
+void initDynamicText(DynamicText* dynamicText, FontAtlas* atlas, SDL_Rect rect, SDL_Color color);
+void setDynamicText(DynamicText* dynamicText, const char* format, ...);
+void drawDynamicText(DynamicText* dynamicText);
+SDL_Texture* createTextTexture(const char* text, SDL_Color color);
+
+#endif
@@ -0,0 +1,49 @@
+#include "timing.h"
+#include "profile.h"
+
+static PacingMode pacingMode = PACING_CAPPED;
+static Uint64 counterFrequency = 0;
+static Uint64 framePeriod = 0;   // Durée cible d'une frame en ticks du compteur
+static Uint64 frameStart = 0;
+static Uint64 lastFrameStart = 0;
+
+void initFramePacing(PacingMode mode, int targetFps) {
+    pacingMode = mode;
+    counterFrequency = SDL_GetPerformanceFrequency();
+    if (targetFps <= 0) targetFps = DEFAULT_FPS;
+    framePeriod = counterFrequency / targetFps;
+    frameStart = SDL_GetPerformanceCounter();
+    lastFrameStart = frameStart;
+}
+
+PacingMode getPacingMode() {
+    return pacingMode;
+}
+
+// Début de frame : renvoie le temps réel écoulé depuis la frame précédente
+double beginFrame() {
+    if (counterFrequency == 0) initFramePacing(pacingMode, DEFAULT_FPS);
+    PROFILE_FRAME();
+    frameStart = SDL_GetPerformanceCounter();
+    double elapsed = (double)(frameStart - lastFrameStart) / counterFrequency;
+    lastFrameStart = frameStart;
+    if (elapsed > MAX_FRAME_SECONDS) elapsed = MAX_FRAME_SECONDS;
+    return elapsed;
+}
+
+// Fin de frame : en mode limité, dort l'essentiel du temps restant puis
+// attend activement la dernière milliseconde pour ne pas dépendre de la
+// granularité de l'ordonnanceur
+void endFrame() {
+    if (pacingMode != PACING_CAPPED) return;
+    PROFILE_SCOPE("attente");
+    Uint64 deadline = frameStart + framePeriod;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= deadline) return;
+    Uint64 remainingMs = (deadline - now) * 1000 / counterFrequency;
+    if (remainingMs > 1) {
+        SDL_Delay((Uint32)(remainingMs - 1));
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+    }
+}
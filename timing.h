@@ -0,0 +1,23 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <SDL.h>
+
+// La simulation avance toujours par pas fixes, quelle que soit la cadence d'affichage
+#define TICK_RATE 60
+#define TICK_SECONDS (1.0 / TICK_RATE)
+#define MAX_FRAME_SECONDS 0.25 // Évite de rattraper des secondes entières après un blocage
+#define DEFAULT_FPS 60
+
+typedef enum {
+    PACING_CAPPED,   // Limiteur basé sur SDL_GetPerformanceCounter
+    PACING_VSYNC,    // SDL_RenderPresent attend la synchro verticale
+    PACING_UNCAPPED  // Aucune attente (écrans 144/240 Hz, mesures)
+} PacingMode;
+
+void initFramePacing(PacingMode mode, int targetFps);
+PacingMode getPacingMode();
+double beginFrame();
+void endFrame();
+
+#endif
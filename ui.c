@@ -0,0 +1,314 @@
+#include "ui.h"
+#include "draw.h"
+#include "profile.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static SDL_Renderer* uiRenderer = NULL;
+static Ui* loadedUis[MAX_UIS]; // Pour libérer les visuels à la fermeture du jeu
+static int loadedUiCount = 0;
+static int uiTextureCount = 0; // Visuels pré-rendus encore alloués
+
+void initUi(SDL_Renderer* renderer) {
+    uiRenderer = renderer;
+}
+
+static void destroyTexture(SDL_Texture* texture) {
+    if (!texture) return;
+    SDL_DestroyTexture(texture);
+    uiTextureCount--;
+}
+
+static void destroyWidgetTextures(Widget* widget) {
+    destroyTexture(widget->normalTexture);
+    destroyTexture(widget->hoverTexture);
+    destroyTexture(widget->selectedTexture);
+    widget->normalTexture = NULL;
+    widget->hoverTexture = NULL;
+    widget->selectedTexture = NULL;
+}
+
+void cleanupUi() {
+    for (int i = 0; i < loadedUiCount; i++) {
+        for (int j = 0; j < loadedUis[i]->widgetCount; j++) {
+            destroyWidgetTextures(&loadedUis[i]->widgets[j]);
+        }
+        loadedUis[i]->loaded = false;
+    }
+    loadedUiCount = 0;
+}
+
+static SDL_Rect textRectOf(const WidgetDef* def) {
+    if (def->textRect.w == 0 || def->textRect.h == 0) {
+        return (SDL_Rect){0, 0, def->rect.w, def->rect.h};
+    }
+    return def->textRect;
+}
+
+// Dessine le widget une fois dans une texture cible de la taille de son rectangle
+static SDL_Texture* prerenderWidget(const WidgetDef* def, SDL_Color color, bool withBackground, bool withText) {
+    SDL_Texture* texture = SDL_CreateTexture(uiRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                             def->rect.w, def->rect.h);
+    if (!texture) {
+        printf("Erreur de création du visuel du widget %d : %s\n", def->id, SDL_GetError());
+        return NULL;
+    }
+    uiTextureCount++;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(uiRenderer);
+    SDL_SetRenderTarget(uiRenderer, texture);
+    SDL_SetRenderDrawColor(uiRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(uiRenderer);
+
+    SDL_Rect local = {0, 0, def->rect.w, def->rect.h};
+    if (withBackground) {
+        drawRoundedRect(uiRenderer, local, def->radius, color);
+    }
+    if (def->type == WIDGET_TEXT_FIELD) {
+        SDL_SetRenderDrawColor(uiRenderer, 255, 255, 255, 255);
+        SDL_RenderDrawRect(uiRenderer, &local);
+    }
+    if (withText && def->text) {
+        drawText(getDefaultFont(), def->text, textRectOf(def), UI_TEXT_COLOR);
+    }
+    SDL_SetRenderTarget(uiRenderer, previousTarget);
+    return texture;
+}
+
+static void prerenderVisuals(Widget* widget) {
+    const WidgetDef* def = &widget->def;
+    bool staticText = !(def->flags & UI_DYNAMIC);
+    switch (def->type) {
+        case WIDGET_BUTTON:
+            widget->normalTexture = prerenderWidget(def, def->color, true, staticText);
+            if (!(def->flags & UI_NO_HOVER)) {
+                widget->hoverTexture = prerenderWidget(def, def->hoverColor, true, staticText);
+            }
+            if (def->flags & UI_SELECTABLE) {
+                widget->selectedTexture = prerenderWidget(def, def->selectedColor, true, staticText);
+            }
+            break;
+        case WIDGET_LABEL:
+        case WIDGET_TEXT_FIELD:
+            if (staticText || (def->flags & UI_BACKGROUND) || def->type == WIDGET_TEXT_FIELD) {
+                widget->normalTexture = prerenderWidget(def, def->color, def->flags & UI_BACKGROUND, staticText);
+            }
+            break;
+        case WIDGET_GRID:
+            // Le contenu des cases est dessiné par l'écran propriétaire
+            break;
+    }
+}
+
+static void indexWidget(Ui* ui, int widgetIndex) {
+    SDL_Rect rect = ui->widgets[widgetIndex].def.rect;
+    int firstColumn = SDL_max(rect.x / UI_INDEX_CELL, 0);
+    int lastColumn = SDL_min((rect.x + rect.w - 1) / UI_INDEX_CELL, UI_INDEX_COLUMNS - 1);
+    int firstRow = SDL_max(rect.y / UI_INDEX_CELL, 0);
+    int lastRow = SDL_min((rect.y + rect.h - 1) / UI_INDEX_CELL, UI_INDEX_ROWS - 1);
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            UiIndexCell* cell = &ui->index[row][column];
+            if (cell->count < UI_INDEX_DEPTH) {
+                cell->widgets[cell->count++] = widgetIndex;
+            } else {
+                printf("Index de l'interface saturé en (%d, %d)\n", column, row);
+            }
+        }
+    }
+}
+
+static int gridCellAt(const Widget* widget, int x, int y) {
+    const WidgetDef* def = &widget->def;
+    int step = def->cellSize + def->padding;
+    int localX = x - def->rect.x;
+    int localY = y - def->rect.y;
+    if (localX < 0 || localY < 0 || localX % step >= def->cellSize || localY % step >= def->cellSize) {
+        return -1;
+    }
+    int cell = (localY / step) * def->columns + localX / step;
+    return (localX / step < def->columns && cell < def->cellCount) ? cell : -1;
+}
+
+// Recherche du widget sous le curseur : seuls les widgets de la case de l'index sont testés
+static int hitTest(Ui* ui, int x, int y, int* cell) {
+    *cell = -1;
+    if (x < 0 || y < 0 || x >= UI_INDEX_COLUMNS * UI_INDEX_CELL || y >= UI_INDEX_ROWS * UI_INDEX_CELL) {
+        return -1;
+    }
+    UiIndexCell* indexCell = &ui->index[y / UI_INDEX_CELL][x / UI_INDEX_CELL];
+    SDL_Point point = {x, y};
+    // Les derniers widgets déclarés sont au-dessus
+    for (int i = indexCell->count - 1; i >= 0; i--) {
+        Widget* widget = &ui->widgets[indexCell->widgets[i]];
+        if (!widget->visible || widget->def.type == WIDGET_LABEL) continue;
+        if (!SDL_PointInRect(&point, &widget->def.rect)) continue;
+        if (widget->def.type == WIDGET_GRID) {
+            *cell = gridCellAt(widget, x, y);
+            if (*cell < 0) continue;
+        }
+        return indexCell->widgets[i];
+    }
+    return -1;
+}
+
+static void updateHover(Ui* ui, int x, int y) {
+    ui->hovered = hitTest(ui, x, y, &ui->hoveredCell);
+}
+
+static void resetUi(Ui* ui) {
+    for (int i = 0; i < ui->widgetCount; i++) {
+        Widget* widget = &ui->widgets[i];
+        widget->visible = !(widget->def.flags & UI_HIDDEN);
+        widget->selected = false;
+        widget->value[0] = '\0';
+        widget->length = 0;
+        if (widget->def.flags & UI_DYNAMIC || widget->def.type == WIDGET_TEXT_FIELD) {
+            SDL_Rect rect = textRectOf(&widget->def);
+            rect.x += widget->def.rect.x;
+            rect.y += widget->def.rect.y;
+            initDynamicText(&widget->dynamicText, getDefaultFont(), rect, UI_TEXT_COLOR);
+        }
+        if (widget->def.type == WIDGET_TEXT_FIELD && ui->focused < 0) {
+            ui->focused = i;
+        }
+    }
+    ui->activatedCell = -1;
+    // Position initiale du curseur, ensuite suivie par les événements
+    int x, y;
+    SDL_GetMouseState(&x, &y);
+    updateHover(ui, x, y);
+}
+
+void uiLoad(Ui* ui, const WidgetDef* defs, int count) {
+    if (!ui->loaded) {
+        memset(ui, 0, sizeof(Ui));
+        ui->widgetCount = SDL_min(count, MAX_WIDGETS);
+        for (int i = 0; i < ui->widgetCount; i++) {
+            ui->widgets[i].def = defs[i];
+            if (defs[i].type == WIDGET_GRID) {
+                int step = defs[i].cellSize + defs[i].padding;
+                int rows = (defs[i].cellCount + defs[i].columns - 1) / defs[i].columns;
+                ui->widgets[i].def.rect.w = defs[i].columns * step - defs[i].padding;
+                ui->widgets[i].def.rect.h = rows * step - defs[i].padding;
+            }
+            prerenderVisuals(&ui->widgets[i]);
+            indexWidget(ui, i);
+        }
+        ui->loaded = true;
+        if (loadedUiCount < MAX_UIS) {
+            loadedUis[loadedUiCount++] = ui;
+        }
+    }
+    ui->focused = -1;
+    resetUi(ui);
+}
+
+int uiHandleEvent(Ui* ui, const SDL_Event* event) {
+    int cell;
+    int hit;
+    switch (event->type) {
+        case SDL_MOUSEMOTION:
+            updateHover(ui, event->motion.x, event->motion.y);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+            hit = hitTest(ui, event->button.x, event->button.y, &cell);
+            if (hit >= 0 && ui->widgets[hit].def.type == WIDGET_TEXT_FIELD) {
+                ui->focused = hit;
+            } else if (hit >= 0) {
+                ui->activatedCell = cell;
+                return ui->widgets[hit].def.id;
+            }
+            break;
+        case SDL_KEYDOWN:
+            if (ui->focused >= 0) {
+                Widget* field = &ui->widgets[ui->focused];
+                SDL_Keycode key = event->key.keysym.sym;
+                if (key == SDLK_BACKSPACE && field->length > 0) {
+                    field->value[--field->length] = '\0';
+                } else if (key >= SDLK_a && key <= SDLK_z && field->length < MAX_FIELD_LENGTH) {
+                    field->value[field->length++] = key;
+                    field->value[field->length] = '\0';
+                } else if (key == SDLK_RETURN) {
+                    return field->def.id;
+                }
+                setDynamicText(&field->dynamicText, "%s", field->value);
+            }
+            break;
+    }
+    return UI_NONE;
+}
+
+void uiRender(Ui* ui) {
+    PROFILE_SCOPE("uiRender");
+    for (int i = 0; i < ui->widgetCount; i++) {
+        Widget* widget = &ui->widgets[i];
+        if (!widget->visible) continue;
+        SDL_Texture* texture = widget->normalTexture;
+        if (widget->selected && widget->selectedTexture) {
+            texture = widget->selectedTexture;
+        } else if (i == ui->hovered && widget->hoverTexture) {
+            texture = widget->hoverTexture;
+        }
+        if (texture) {
+            SDL_RenderCopy(uiRenderer, texture, NULL, &widget->def.rect);
+        }
+        if (widget->def.flags & UI_DYNAMIC || widget->def.type == WIDGET_TEXT_FIELD) {
+            drawDynamicText(&widget->dynamicText);
+        }
+    }
+}
+
+int getUiTextureCount() {
+    return uiTextureCount;
+}
+
+Widget* uiFind(Ui* ui, int id) {
+    for (int i = 0; i < ui->widgetCount; i++) {
+        if (ui->widgets[i].def.id == id) return &ui->widgets[i];
+    }
+    return NULL;
+}
+
+void uiSetVisible(Ui* ui, int id, bool visible) {
+    Widget* widget = uiFind(ui, id);
+    if (widget) widget->visible = visible;
+}
+
+void uiSetSelected(Ui* ui, int id, bool selected) {
+    Widget* widget = uiFind(ui, id);
+    if (widget) widget->selected = selected;
+}
+
+void uiSetText(Ui* ui, int id, const char* format, ...) {
+    Widget* widget = uiFind(ui, id);
+    if (!widget) return;
+    char buffer[MAX_TEXT_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    setDynamicText(&widget->dynamicText, "%s", buffer);
+}
+
+const char* uiGetText(Ui* ui, int id) {
+    Widget* widget = uiFind(ui, id);
+    return widget ? widget->value : "";
+}
+
+bool uiIsHovered(Ui* ui, int id) {
+    return ui->hovered >= 0 && ui->widgets[ui->hovered].def.id == id;
+}
+
+SDL_Rect uiGetCellRect(Ui* ui, int id, int cell) {
+    Widget* widget = uiFind(ui, id);
+    SDL_Rect rect = {0, 0, 0, 0};
+    if (!widget || widget->def.type != WIDGET_GRID) return rect;
+    int step = widget->def.cellSize + widget->def.padding;
+    rect.x = widget->def.rect.x + (cell % widget->def.columns) * step;
+    rect.y = widget->def.rect.y + (cell / widget->def.columns) * step;
+    rect.w = widget->def.cellSize;
+    rect.h = widget->def.cellSize;
+    return rect;
+}
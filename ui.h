@@ -0,0 +1,106 @@
+#ifndef UI_H
+#define UI_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include "text.h"
+
+#define UI_NONE 0
+#define MAX_WIDGETS 32
+#define MAX_UIS 16
+#define MAX_FIELD_LENGTH 49
+
+// Index spatial : grille uniforme couvrant l'écran
+#define UI_INDEX_CELL 64
+#define UI_INDEX_COLUMNS 16
+#define UI_INDEX_ROWS 16
+#define UI_INDEX_DEPTH 8
+
+// Options des widgets
+#define UI_NO_HOVER 0x01    // Pas de visuel de survol
+#define UI_SELECTABLE 0x02  // Possède un visuel "sélectionné" (onglets)
+#define UI_DYNAMIC 0x04     // Texte modifiable via uiSetText
+#define UI_BACKGROUND 0x08  // Label dessiné sur un fond arrondi
+#define UI_HIDDEN 0x10      // Invisible au chargement
+
+#define UI_TEXT_COLOR ((SDL_Color){255, 255, 255, 255})
+#define UI_BUTTON_COLOR ((SDL_Color){0, 0, 255, 255})
+#define UI_HOVER_COLOR ((SDL_Color){0, 255, 0, 255})
+#define UI_SELECTED_COLOR ((SDL_Color){255, 165, 0, 255})
+
+typedef enum {
+    WIDGET_BUTTON,
+    WIDGET_LABEL,
+    WIDGET_TEXT_FIELD,
+    WIDGET_GRID
+} WidgetType;
+
+// Déclaration d'un widget : les menus sont décrits par des tableaux de WidgetDef
+typedef struct {
+    WidgetType type;
+    int id;               // Renvoyé par uiHandleEvent lors d'une activation
+    SDL_Rect rect;
+    const char* text;
+    SDL_Rect textRect;    // Relatif à rect, rect entier si vide
+    int radius;
+    SDL_Color color;
+    SDL_Color hoverColor;
+    SDL_Color selectedColor;
+    int flags;
+    // Grille
+    int columns;
+    int cellCount;
+    int cellSize;
+    int padding;
+} WidgetDef;
+
+#define UI_BUTTON(ID, X, Y, W, H, TEXT, TX, TY, TW, TH) \
+    { .type = WIDGET_BUTTON, .id = (ID), .rect = {X, Y, W, H}, .text = (TEXT), .textRect = {TX, TY, TW, TH}, \
+      .radius = 20, .color = UI_BUTTON_COLOR, .hoverColor = UI_HOVER_COLOR }
+
+#define UI_LABEL(ID, X, Y, W, H, TEXT) \
+    { .type = WIDGET_LABEL, .id = (ID), .rect = {X, Y, W, H}, .text = (TEXT) }
+
+typedef struct {
+    WidgetDef def;
+    SDL_Texture* normalTexture;   // Visuels pré-rendus une seule fois
+    SDL_Texture* hoverTexture;
+    SDL_Texture* selectedTexture;
+    bool visible;
+    bool selected;
+    DynamicText dynamicText;      // Labels dynamiques et champs de saisie
+    char value[MAX_FIELD_LENGTH + 1];
+    int length;
+} Widget;
+
+typedef struct {
+    Uint8 count;
+    Uint8 widgets[UI_INDEX_DEPTH];
+} UiIndexCell;
+
+typedef struct {
+    bool loaded;
+    Widget widgets[MAX_WIDGETS];
+    int widgetCount;
+    int hovered;         // Index du widget survolé, -1 sinon
+    int hoveredCell;     // Case survolée dans une grille, -1 sinon
+    int activatedCell;   // Case cliquée lors de la dernière activation d'une grille
+    int focused;         // Champ de saisie recevant le clavier, -1 sinon
+    UiIndexCell index[UI_INDEX_ROWS][UI_INDEX_COLUMNS];
+} Ui;
+
+void initUi(SDL_Renderer* renderer);
+void cleanupUi();
+int getUiTextureCount();
+void uiLoad(Ui* ui, const WidgetDef* defs, int count);
+int uiHandleEvent(Ui* ui, const SDL_Event* event);
+void uiRender(Ui* ui);
+Widget* uiFind(Ui* ui, int id);
+void uiSetVisible(Ui* ui, int id, bool visible);
+void uiSetSelected(Ui* ui, int id, bool selected);
+void uiSetText(Ui* ui, int id, const char* format, ...);
+const char* uiGetText(Ui* ui, int id);
+bool uiIsHovered(Ui* ui, int id);
+SDL_Rect uiGetCellRect(Ui* ui, int id, int cell);
+
+#endif
@@ -0,0 +1,180 @@
+// Outil hors ligne : rejoue des parties enregistrées (voir replay.h) sans
+// fenêtre et signale celles dont le temps de survie recalculé diffère du
+// temps annoncé. Une partie dont les réglages ne sont pas ceux de sa
+// difficulté est invalide, sauf si elle est marquée hors classement.
+// Utilisation :
+//   ./valoverify [--threads N] [--list fichiers.txt] partie1.replay ...
+// --list lit un chemin par ligne, pour les lots trop grands pour la ligne de commande.
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "replay.h"
+
+#define VERIFY_TICK_RATE 60 // Même cadence que TICK_RATE (timing.h)
+#define VERIFY_MAX_THREADS 256
+
+typedef enum {
+    VERIFY_OK,
+    VERIFY_MISMATCH,
+    VERIFY_INVALID
+} VerifyStatus;
+
+typedef struct {
+    const char* path;
+    VerifyStatus status;
+    uint32_t claimedTicks;
+    uint32_t simulatedTicks;
+    bool claimedOver;
+    bool simulatedOver;
+    bool unranked; // REPLAY_FLAG_UNRANKED : vérifiée mais jamais classée
+} VerifyResult;
+
+typedef struct {
+    VerifyResult* results;
+    int count;
+    atomic_int next; // Prochaine partie à prendre : les threads rapides en prennent plus
+} VerifyBatch;
+
+static void verifyRun(VerifyResult* result) {
+    Replay replay;
+    Simulation sim;
+    if (!replayLoad(&replay, result->path)) {
+        result->status = VERIFY_INVALID;
+        return;
+    }
+    // Sinon une partie « difficile » à une balle immobile passerait pour valide
+    result->unranked = (replay.flags & REPLAY_FLAG_UNRANKED) != 0;
+    if (!result->unranked && !replayMatchesDifficulty(&replay)) {
+        replayFree(&replay);
+        result->status = VERIFY_INVALID;
+        return;
+    }
+    if (!replayStartSimulation(&replay, &sim)) {
+        replayFree(&replay);
+        result->status = VERIFY_INVALID;
+        return;
+    }
+    result->claimedTicks = replay.tickCount;
+    result->claimedOver = (replay.flags & REPLAY_FLAG_OVER) != 0;
+    result->simulatedTicks = replayRun(&replay, &sim);
+    result->simulatedOver = sim.over;
+    // Une collision plus tôt ou plus tard que prévu change le temps de survie
+    bool matches = result->simulatedTicks == result->claimedTicks && result->simulatedOver == result->claimedOver;
+    result->status = matches ? VERIFY_OK : VERIFY_MISMATCH;
+    simFree(&sim);
+    replayFree(&replay);
+}
+
+static void* verifyThread(void* context) {
+    VerifyBatch* batch = context;
+    int index;
+    while ((index = atomic_fetch_add(&batch->next, 1)) < batch->count) {
+        verifyRun(&batch->results[index]);
+    }
+    return NULL;
+}
+
+static bool addPath(VerifyResult** results, int* count, int* capacity, const char* path) {
+    if (*count == *capacity) {
+        int grown = *capacity > 0 ? *capacity * 2 : 1024;
+        VerifyResult* resized = realloc(*results, grown * sizeof(VerifyResult));
+        if (!resized) return false;
+        *results = resized;
+        *capacity = grown;
+    }
+    memset(&(*results)[*count], 0, sizeof(VerifyResult));
+    (*results)[(*count)++].path = path;
+    return true;
+}
+
+// Les chemins lus restent alloués jusqu'à la fin du programme
+static bool readList(const char* listPath, VerifyResult** results, int* count, int* capacity) {
+    FILE* file = fopen(listPath, "r");
+    if (!file) {
+        printf("Impossible d'ouvrir la liste %s\n", listPath);
+        return false;
+    }
+    char line[4096];
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') continue;
+        char* path = strdup(line);
+        ok = path && addPath(results, count, capacity, path);
+    }
+    fclose(file);
+    if (!ok) printf("Erreur d'allocation memoire pour la liste %s\n", listPath);
+    return ok;
+}
+
+static double secondsSince(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    int threadCount = 0; // Un par cœur par défaut
+    VerifyResult* results = NULL;
+    int count = 0, capacity = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--list") == 0 && i + 1 < argc) {
+            if (!readList(argv[++i], &results, &count, &capacity)) return 1;
+        } else if (!addPath(&results, &count, &capacity, argv[i])) {
+            printf("Erreur d'allocation memoire\n");
+            return 1;
+        }
+    }
+    if (count == 0) {
+        printf("Utilisation : %s [--threads N] [--list fichiers.txt] partie.replay ...\n", argv[0]);
+        return 1;
+    }
+    if (threadCount <= 0) threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > VERIFY_MAX_THREADS) threadCount = VERIFY_MAX_THREADS;
+    if (threadCount > count) threadCount = count;
+
+    // Choisi avant le départ des threads : tous utilisent les mêmes noyaux.
+    // Le pool de jobs n'est pas démarré, chaque partie tourne sur un seul cœur.
+    printf("Verification de %d partie(s) sur %d thread(s), physique %s\n", count, threadCount, getPhysicsBackendName());
+    VerifyBatch batch = {results, count, 0};
+    pthread_t threads[VERIFY_MAX_THREADS];
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int started = 0;
+    for (; started < threadCount; started++) {
+        if (pthread_create(&threads[started], NULL, verifyThread, &batch) != 0) break;
+    }
+    if (started == 0) verifyThread(&batch);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = secondsSince(&start);
+
+    int mismatches = 0, invalid = 0, unranked = 0;
+    uint64_t totalTicks = 0;
+    for (int i = 0; i < count; i++) {
+        const VerifyResult* result = &results[i];
+        totalTicks += result->simulatedTicks;
+        if (result->unranked) unranked++;
+        if (result->status == VERIFY_INVALID) {
+            invalid++;
+            printf("INVALIDE %s\n", result->path);
+        } else if (result->status == VERIFY_MISMATCH) {
+            mismatches++;
+            printf("DIFFERENT %s : annonce %u s (%u pas%s), recalcule %u s (%u pas%s)\n", result->path,
+                   result->claimedTicks / VERIFY_TICK_RATE, result->claimedTicks, result->claimedOver ? "" : ", sans collision",
+                   result->simulatedTicks / VERIFY_TICK_RATE, result->simulatedTicks, result->simulatedOver ? "" : ", sans collision");
+        }
+    }
+    printf("%d partie(s) dont %d hors classement, %d differente(s), %d invalide(s) en %.2f s (%.0f parties/s, %.1f M pas/s)\n",
+           count, unranked, mismatches, invalid, elapsed, count / elapsed, totalTicks / elapsed / 1e6);
+    free(results);
+    return mismatches > 0 || invalid > 0 ? 2 : 0;
+}